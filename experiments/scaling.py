@@ -0,0 +1,290 @@
+# MIT License
+#
+# Copyright (c) 2017 André L. Maravilha
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+'''
+This script measures how the heuristic phase scales with the size of the model,
+the size of the pool and the number of sub-MIP workers. Each run has a fixed
+budget of time for the heuristic phase, and its statistics (sub-MIPs per second,
+improvements per second and peak memory) are collected from the file written by
+the option --stats. Runs are executed one after another, since concurrent runs
+would disturb the measures.
+
+Three studies are performed:
+  * size: the heuristic runs on a ladder of instances of increasing size;
+  * strong: the heuristic runs on each instance with 1...N workers (parallel
+    efficiency = rate(p) / (p * rate(1)));
+  * weak: the size of the instance grows with the number of workers (the
+    instance has one independent block per worker and parallel efficiency =
+    rate(p) / rate(1)).
+
+The instances are either given (e.g., MIPLIB instances, in increasing order of
+size) or generated (random set covering problems with independent blocks).
+'''
+
+import argparse
+import csv
+import json
+import os
+import random
+import statistics
+import subprocess
+import sys
+import tempfile
+
+
+###################################################################################################
+# Writes a random set covering problem (LP format) made of independent blocks. Each block has the
+# given number of columns and one row for every five columns.
+#
+def generate_instance(filename, columns, blocks, seed):
+    rng = random.Random(seed)
+    rows_per_block = max(1, columns // 5)
+
+    with open(filename, "w") as f:
+
+        # Objective function
+        f.write("Minimize\n obj:")
+        for b in range(blocks):
+            for j in range(columns):
+                f.write(" + {} x{}_{}".format(rng.randint(1, 100), b, j))
+                if (j + 1) % 10 == 0:
+                    f.write("\n")
+        f.write("\nSubject To\n")
+
+        # Covering constraints (each column covers at least one row of its block)
+        for b in range(blocks):
+            covers = [[] for _ in range(rows_per_block)]
+            for j in range(columns):
+                for i in rng.sample(range(rows_per_block), min(rows_per_block, rng.randint(1, 4))):
+                    covers[i].append(j)
+            for i in range(rows_per_block):
+                if len(covers[i]) == 0:
+                    covers[i].append(rng.randrange(columns))
+                f.write(" c{}_{}:".format(b, i))
+                for k, j in enumerate(covers[i]):
+                    f.write(" + x{}_{}".format(b, j))
+                    if (k + 1) % 10 == 0:
+                        f.write("\n")
+                f.write(" >= 1\n")
+
+        # Variables
+        f.write("Binary\n")
+        for b in range(blocks):
+            for j in range(columns):
+                f.write(" x{}_{}\n".format(b, j))
+        f.write("End\n")
+
+
+###################################################################################################
+# Runs an entry and returns its statistics (or None, if the run failed).
+#
+def run_entry(data, instance, workers, pool_size, seed):
+
+    # Statistics are written by the program into a temporary file
+    handle, stats_file = tempfile.mkstemp(suffix=".json")
+    os.close(handle)
+
+    try:
+
+        # Create the command to run
+        command = ([data["command"], "--details", "0", "--seed", str(seed),
+                    "--heuristic", data["heuristic"],
+                    "--heuristic-trigger-nodes", str(data["trigger-nodes"]),
+                    "--heuristic-absolute-time-limit", str(data["budget"]),
+                    "--pool-size", str(pool_size),
+                    "--submip-workers", str(workers),
+                    "--stats", stats_file] +
+                   (["--submip-split-components"] if workers > 0 else []) +
+                   data["extra"] + ["--file", instance])
+
+        # Run the command
+        output = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                                universal_newlines=True)
+
+        # Check if the command run without errors
+        if output.returncode != 0:
+            return None
+
+        with open(stats_file, "r") as f:
+            return json.load(f)
+
+    except (OSError, ValueError):
+        return None
+
+    finally:
+        os.remove(stats_file)
+
+
+###################################################################################################
+# Builds the scaling curves: median of the measures of each point (over the seeds) and parallel
+# efficiency regarding the point with a single worker of the same curve.
+#
+def build_curves(rows):
+    points = dict()
+    for row in rows:
+        key = (row["study"], row["curve"], row["workers"], row["pool_size"], row["size"])
+        points.setdefault(key, []).append(row)
+
+    curves = dict()
+    for (study, curve, workers, pool_size, size), entries in sorted(points.items()):
+        point = dict()
+        point["workers"] = workers
+        point["pool_size"] = pool_size
+        point["size"] = size
+        point["runs"] = len(entries)
+        for measure in ["submips_per_second", "improvements_per_second", "peak_memory_kb"]:
+            point[measure] = statistics.median([entry[measure] for entry in entries])
+        curves.setdefault(study, dict()).setdefault(curve, []).append(point)
+
+    for study in ["strong", "weak"]:
+        for points_of_curve in curves.get(study, dict()).values():
+            base = [point for point in points_of_curve if point["workers"] <= 1]
+            base_rate = base[0]["submips_per_second"] if len(base) > 0 else 0.0
+            for point in points_of_curve:
+                p = max(1, point["workers"])
+                ideal = (p if study == "strong" else 1) * base_rate
+                point["efficiency"] = (point["submips_per_second"] / ideal) if ideal > 0 else None
+
+    return curves
+
+
+###################################################################################################
+# Main function
+#
+def main():
+
+    # Configure argument parser
+    parser = argparse.ArgumentParser(description="Measure the scaling of the heuristic phase.")
+    parser.add_argument("--command", default="../build/itor", help="Path to the program.")
+    parser.add_argument("--heuristic", default="rothberg", help="Heuristic to measure.")
+    parser.add_argument("--budget", type=float, default=60.0,
+                        help="Time (in seconds) of the heuristic phase of each run.")
+    parser.add_argument("--trigger-nodes", type=int, default=1000,
+                        help="MIP nodes explored before the heuristic phase.")
+    parser.add_argument("--instances", nargs="*", default=[],
+                        help="Instances of the size ladder, in increasing order of size (if not "
+                             "set, instances are generated).")
+    parser.add_argument("--sizes", default="1000,2000,4000,8000",
+                        help="Number of columns of the generated instances of the size ladder.")
+    parser.add_argument("--workers", default="1,2,4,8",
+                        help="Numbers of sub-MIP workers of the strong and weak scaling studies.")
+    parser.add_argument("--pool-sizes", default="40", help="Sizes of the pool of solutions.")
+    parser.add_argument("--seeds", default="29,173,281", help="Seeds of each entry.")
+    parser.add_argument("--studies", default="size,strong,weak", help="Studies to perform.")
+    parser.add_argument("--extra", default="", help="Additional options given to the program.")
+    parser.add_argument("--instances-path", default="./generated",
+                        help="Directory to write the generated instances.")
+    parser.add_argument("--output-csv", default="scaling.csv", help="File to write every run.")
+    parser.add_argument("--output-json", default="scaling.json", help="File to write the curves.")
+
+    # Parse input arguments
+    args = parser.parse_args()
+
+    # Map used to store data necessary to run the experiments
+    data = dict()
+    data["command"] = args.command
+    data["heuristic"] = args.heuristic
+    data["budget"] = args.budget
+    data["trigger-nodes"] = args.trigger_nodes
+    data["extra"] = args.extra.split()
+
+    sizes = [int(v) for v in args.sizes.split(",")]
+    workers = [int(v) for v in args.workers.split(",")]
+    pool_sizes = [int(v) for v in args.pool_sizes.split(",")]
+    seeds = [int(v) for v in args.seeds.split(",")]
+    studies = args.studies.split(",")
+
+    # Size ladder (given or generated)
+    os.makedirs(args.instances_path, exist_ok=True)
+    if len(args.instances) > 0:
+        ladder = [(instance, os.path.getsize(instance)) for instance in args.instances]
+    else:
+        ladder = []
+        for size in sizes:
+            instance = os.path.join(args.instances_path, "setcover-{}.lp".format(size))
+            generate_instance(instance, size, 1, size)
+            ladder.append((instance, size))
+
+    # Entries of each study: (study, curve, instance, size, workers, pool size)
+    entries = []
+    for pool_size in pool_sizes:
+        if "size" in studies:
+            for instance, size in ladder:
+                entries.append(("size", "pool-{}".format(pool_size), instance, size, 0, pool_size))
+
+        if "strong" in studies:
+            for instance, size in ladder:
+                for p in workers:
+                    entries.append(("strong", os.path.basename(instance), instance, size, p,
+                                    pool_size))
+
+        if "weak" in studies:
+            for p in workers:
+                instance = os.path.join(args.instances_path,
+                                        "setcover-{}x{}.lp".format(sizes[0], p))
+                generate_instance(instance, sizes[0], p, sizes[0])
+                entries.append(("weak", "pool-{}".format(pool_size), instance, sizes[0] * p, p,
+                                pool_size))
+
+    # Run each entry (one after another)
+    fields = ["study", "curve", "instance", "size", "workers", "pool_size", "seed", "status",
+              "objective_after", "submips", "improvements", "time_heuristic",
+              "submips_per_second", "improvements_per_second", "peak_memory_kb"]
+    rows = []
+    total_entries = len(entries) * len(seeds)
+    progress = 0
+
+    with open(args.output_csv, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fields, extrasaction="ignore")
+        writer.writeheader()
+
+        for study, curve, instance, size, p, pool_size in entries:
+            for seed in seeds:
+                result = run_entry(data, instance, p, pool_size, seed)
+                progress += 1
+
+                status = result["status"] if result is not None else "Error"
+                print("[{:3} of {:3} ({:6.2f}%) completed] {:6} -> {:16} -> {:3} -> {:4} -> {:8}"
+                      .format(progress, total_entries, progress / total_entries * 100, study,
+                              os.path.basename(instance), p, seed, status))
+                sys.stdout.flush()
+
+                if result is None:
+                    continue
+
+                row = dict(result)
+                row.update({"study": study, "curve": curve, "instance": instance, "size": size,
+                            "workers": p, "pool_size": pool_size, "seed": seed})
+                writer.writerow(row)
+                f.flush()
+                rows.append(row)
+
+    # Write the scaling curves
+    with open(args.output_json, "w") as f:
+        json.dump(build_curves(rows), f, indent=2)
+
+
+###################################################################################################
+# Main statements
+#
+if __name__ == "__main__":
+    main()
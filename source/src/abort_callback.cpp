@@ -1,19 +1,26 @@
 #include "abort_callback.h"
 #include <chrono>
+#include <cmath>
+#include <algorithm>
 
 
 IloCplex::Callback orcs::AbortCallback::create_instance(IloEnv& env, const cxxtimer::Timer* timer,
-        double time_limit, unsigned long long nodes_limit, unsigned long long nodes_unsuccessful)
+        double time_limit, unsigned long long nodes_limit, unsigned long long nodes_unsuccessful,
+        IloObjective::Sense sense, double target, const StallCriterion& stall,
+        IncumbentBroadcast* broadcast, bool* preempted)
 {
     return (IloCplex::Callback(new (env) orcs::AbortCallback(env, timer, time_limit,
-            nodes_limit, nodes_unsuccessful)));
+            nodes_limit, nodes_unsuccessful, sense, target, stall, broadcast, preempted)));
 }
 
 orcs::AbortCallback::AbortCallback(IloEnv& env, const cxxtimer::Timer* timer, double time_limit,
-        unsigned long long nodes_limit, unsigned long long nodes_unsuccessful) :
+        unsigned long long nodes_limit, unsigned long long nodes_unsuccessful,
+        IloObjective::Sense sense, double target, const StallCriterion& stall,
+        IncumbentBroadcast* broadcast, bool* preempted) :
     IloCplex::MIPInfoCallbackI(env), timer_(timer), time_limit_(time_limit),
-    nodes_limit_(nodes_limit), initialized_(false), aborted_(false),
-    nodes_unsuccessful_(nodes_unsuccessful)
+    nodes_limit_(nodes_limit), nodes_unsuccessful_(nodes_unsuccessful), sense_(sense),
+    target_(target), stall_(stall), broadcast_(broadcast), preempted_(preempted),
+    initialized_(false), aborted_(false)
 {
     // It does nothing here.
 }
@@ -39,12 +46,47 @@ void orcs::AbortCallback::main() {
     }
 
     // Abort, if maximum number of MIP nodes has been explored
-    if (getNnodes64() >= nodes_limit_) {
+    if (static_cast<unsigned long long>(getNnodes64()) >= nodes_limit_) {
         aborted_ = true;
         abort();
         return;
     }
 
+    // Abort, if the incumbent solution has reached the target value
+    if (!std::isnan(target_) && hasIncumbent()) {
+        IloNum obj_incumbent = getIncumbentObjValue();
+        if ((sense_ == IloObjective::Minimize && obj_incumbent <= target_) ||
+                (sense_ == IloObjective::Maximize && obj_incumbent >= target_)) {
+            aborted_ = true;
+            abort();
+            return;
+        }
+    }
+
+    // Publish the incumbent solution and abort, if the best bound cannot beat
+    // a better solution found elsewhere
+    if (broadcast_ != nullptr) {
+        if (hasIncumbent()) {
+            broadcast_->publish(getIncumbentObjValue());
+        }
+
+        // (a process whose own incumbent is the global one is not aborted: it
+        // closes its gap as usual)
+        IloNum obj_global = broadcast_->value();
+        bool beaten = !hasIncumbent() || (sense_ == IloObjective::Minimize ?
+                getIncumbentObjValue() - obj_global > 1e-5 :
+                obj_global - getIncumbentObjValue() > 1e-5);
+
+        if (beaten && broadcast_->dominates(getBestObjValue())) {
+            if (preempted_ != nullptr) {
+                *preempted_ = true;
+            }
+            aborted_ = true;
+            abort();
+            return;
+        }
+    }
+
     // Abort, if maximum number of MIP nodes without improvement has been reached
     if (!initialized_) {
         initialized_ = true;
@@ -56,15 +98,43 @@ void orcs::AbortCallback::main() {
         IloNum obj_current_incumbent = getIncumbentObjValue();
         IloInt64 nnodes = getNnodes64();
 
-        if (obj_last_incumbent_ - obj_current_incumbent > 1e-5) {
+        bool improved = (sense_ == IloObjective::Minimize ?
+                obj_last_incumbent_ - obj_current_incumbent > 1e-5 :
+                obj_current_incumbent - obj_last_incumbent_ > 1e-5);
+
+        if (improved) {
             obj_last_incumbent_ = obj_current_incumbent;
             nodes_last_incumbent_ = getNnodes64();
 
-        } else if (nnodes - nodes_last_incumbent_ > nodes_unsuccessful_) {
+        } else if (static_cast<unsigned long long>(nnodes - nodes_last_incumbent_) > nodes_unsuccessful_) {
             aborted_ = true;
             abort();
             return;
         }
     }
 
+    // Abort, if the progress over the sliding window is too small
+    if (stall_.enabled() && hasIncumbent()) {
+
+        Sample current {getNnodes64(), getCplexTime(), std::min(1.0, (double) getMIPRelativeGap())};
+        if (window_.empty() || current.nodes > window_.back().nodes) {
+            window_.push_back(current);
+        }
+
+        // Keep the newest sample that spans the entire window as the first one
+        auto spans = [this, &current](const Sample& sample) {
+            return (unsigned long long) (current.nodes - sample.nodes) >= stall_.window_nodes ||
+                    current.time - sample.time >= stall_.window_time;
+        };
+
+        while (window_.size() >= 2 && spans(window_[1])) {
+            window_.pop_front();
+        }
+
+        if (spans(window_.front()) && window_.front().gap - current.gap < stall_.min_progress) {
+            aborted_ = true;
+            abort();
+            return;
+        }
+    }
 }
@@ -2,7 +2,9 @@
 #define ORCS_ABORT_CALLBACK_H
 
 
+#include "incumbent_broadcast.h"
 #include <limits>
+#include <deque>
 #include <ilcplex/ilocplex.h>
 #include <cxxtimer.hpp>
 
@@ -12,6 +14,30 @@ ILOSTLBEGIN
 
 namespace orcs {
 
+
+/**
+ * Stall criterion based on the marginal progress of the optimization process.
+ * The progress is measured as the closure of the relative MIP gap, which 
+ * accounts for both the improvement of the incumbent solution and the movement 
+ * of the best bound. The optimization process is aborted when the gap closed 
+ * over a sliding window (of the last window_nodes nodes or the last 
+ * window_time seconds, whichever is reached first) is less than min_progress.
+ */
+struct StallCriterion {
+    unsigned long long window_nodes;
+    double window_time;
+    double min_progress;
+
+    StallCriterion(unsigned long long window_nodes_ = std::numeric_limits<unsigned long long>::max(),
+            double window_time_ = std::numeric_limits<double>::max(), double min_progress_ = 0.0)
+            : window_nodes(window_nodes_), window_time(window_time_), min_progress(min_progress_) {};
+
+    bool enabled() const {
+        return window_nodes < std::numeric_limits<unsigned long long>::max() ||
+                window_time < std::numeric_limits<double>::max();
+    }
+};
+
     
 /**
  * Callback class used to set custom stopping criteria for the optimization 
@@ -40,11 +66,34 @@ public:
      * @param   nodes_unsuccessful
      *          Abort the optimization process when nodes_unsuccessful have been
      *          explored and no improved solution was found.
+     * @param   sense
+     *          The optimization sense of the problem.
+     * @param   target
+     *          Abort the optimization process as soon as the incumbent solution
+     *          reaches this value of the objective function (i.e., it is lower 
+     *          or equal for minimization problems, greater or equal for 
+     *          maximization ones). If set as NaN, this stopping criterion is 
+     *          ignored.
+     * @param   stall
+     *          Abort the optimization process when its marginal progress is 
+     *          too small. If the criterion is not enabled, it is ignored.
+     * @param   broadcast
+     *          The global incumbent. The incumbent solutions of the
+     *          optimization process are published into it, and the process is
+     *          aborted as soon as its best bound is dominated by a better
+     *          solution found elsewhere. If nullptr, it is ignored.
+     * @param   preempted
+     *          Output: set to true if the process is aborted because its best
+     *          bound is dominated by the global incumbent (or nullptr).
      */
     static IloCplex::Callback create_instance(IloEnv& env, const cxxtimer::Timer* timer = nullptr,
             double time_limit = std::numeric_limits<double>::max(),
             unsigned long long nodes_limit = std::numeric_limits<unsigned long long>::max(),
-            unsigned long long nodes_unsuccessful = std::numeric_limits<unsigned long long>::max());
+            unsigned long long nodes_unsuccessful = std::numeric_limits<unsigned long long>::max(),
+            IloObjective::Sense sense = IloObjective::Minimize,
+            double target = std::numeric_limits<double>::quiet_NaN(),
+            const StallCriterion& stall = StallCriterion(),
+            IncumbentBroadcast* broadcast = nullptr, bool* preempted = nullptr);
     
 protected:
     
@@ -67,10 +116,31 @@ protected:
      * @param   nodes_unsuccessful
      *          Abort the optimization process when nodes_unsuccessful have been
      *          explored and no improved solution was found.
+     * @param   sense
+     *          The optimization sense of the problem.
+     * @param   target
+     *          Abort the optimization process as soon as the incumbent solution
+     *          reaches this value of the objective function (i.e., it is lower 
+     *          or equal for minimization problems, greater or equal for 
+     *          maximization ones). If set as NaN, this stopping criterion is 
+     *          ignored.
+     * @param   stall
+     *          Abort the optimization process when its marginal progress is 
+     *          too small. If the criterion is not enabled, it is ignored.
+     * @param   broadcast
+     *          The global incumbent. The incumbent solutions of the
+     *          optimization process are published into it, and the process is
+     *          aborted as soon as its best bound is dominated by a better
+     *          solution found elsewhere. If nullptr, it is ignored.
+     * @param   preempted
+     *          Output: set to true if the process is aborted because its best
+     *          bound is dominated by the global incumbent (or nullptr).
      */
     AbortCallback(IloEnv& env, const cxxtimer::Timer* timer,
             double time_limit, unsigned long long nodes_limit,
-            unsigned long long nodes_unsuccessful);
+            unsigned long long nodes_unsuccessful, IloObjective::Sense sense,
+            double target, const StallCriterion& stall, IncumbentBroadcast* broadcast,
+            bool* preempted);
 
     IloCplex::CallbackI* duplicateCallback() const override;
     void main() override;
@@ -88,6 +158,11 @@ private:
     double time_limit_;
     unsigned long long nodes_limit_;
     unsigned long long nodes_unsuccessful_;
+    IloObjective::Sense sense_;
+    double target_;
+    StallCriterion stall_;
+    IncumbentBroadcast* broadcast_;
+    bool* preempted_;
 
     /*
      * Status
@@ -100,6 +175,18 @@ private:
      */
     IloNum obj_last_incumbent_;
     IloInt64 nodes_last_incumbent_;
+
+    /*
+     * Sliding window of the progress (number of nodes, time and relative
+     * gap), used by the stall criterion.
+     */
+    struct Sample {
+        IloInt64 nodes;
+        double time;
+        double gap;
+    };
+
+    std::deque<Sample> window_;
     
 };
 
@@ -0,0 +1,77 @@
+#include "bit_vector.h"
+
+
+orcs::BitVector::BitVector(std::size_t size) : size_(0) {
+    reset(size);
+}
+
+void orcs::BitVector::reset(std::size_t size) {
+    size_ = size;
+    words_.assign((size + WORD_BITS - 1) / WORD_BITS, 0);
+}
+
+std::size_t orcs::BitVector::size() const {
+    return size_;
+}
+
+void orcs::BitVector::set(std::size_t idx, bool value) {
+    std::uint64_t bit = (std::uint64_t(1) << (idx % WORD_BITS));
+    if (value) {
+        words_[idx / WORD_BITS] |= bit;
+    } else {
+        words_[idx / WORD_BITS] &= ~bit;
+    }
+}
+
+bool orcs::BitVector::get(std::size_t idx) const {
+    return (words_[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1;
+}
+
+void orcs::BitVector::encode(const IloNumArray& values, const std::vector<std::size_t>& indexes) {
+    reset(indexes.size());
+    for (std::size_t k = 0; k < indexes.size(); ++k) {
+        if (values[indexes[k]] > 0.5) {
+            words_[k / WORD_BITS] |= (std::uint64_t(1) << (k % WORD_BITS));
+        }
+    }
+}
+
+std::size_t orcs::BitVector::count() const {
+    std::size_t total = 0;
+    for (auto word : words_) {
+        total += __builtin_popcountll(word);
+    }
+
+    return total;
+}
+
+bool orcs::BitVector::agrees(const BitVector& other, const BitVector& mask) const {
+    for (std::size_t w = 0; w < words_.size(); ++w) {
+        if ((words_[w] ^ other.words_[w]) & mask.words_[w]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t orcs::BitVector::distance(const BitVector& other, const BitVector& mask) const {
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < words_.size(); ++w) {
+        total += __builtin_popcountll((words_[w] ^ other.words_[w]) & mask.words_[w]);
+    }
+
+    return total;
+}
+
+const std::uint64_t* orcs::BitVector::words() const {
+    return words_.data();
+}
+
+std::uint64_t* orcs::BitVector::words() {
+    return words_.data();
+}
+
+std::size_t orcs::BitVector::num_words() const {
+    return words_.size();
+}
@@ -0,0 +1,140 @@
+#ifndef ORCS_BIT_VECTOR_H
+#define ORCS_BIT_VECTOR_H
+
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * A fixed-size vector of bits packed into 64-bit words, used to encode the
+ * values of the binary variables of solutions (or masks over them) compactly,
+ * so that solutions can be compared by a few word operations.
+ */
+class BitVector {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   size
+     *          The number of bits (all of them are initialized as zero).
+     */
+    explicit BitVector(std::size_t size = 0);
+
+    /**
+     * Resize this vector and set all bits to zero.
+     *
+     * @param   size
+     *          The number of bits.
+     */
+    void reset(std::size_t size);
+
+    /**
+     * Return the number of bits of this vector.
+     *
+     * @return  The number of bits.
+     */
+    std::size_t size() const;
+
+    /**
+     * Set the value of a bit.
+     *
+     * @param   idx
+     *          The index of the bit.
+     * @param   value
+     *          The value of the bit.
+     */
+    void set(std::size_t idx, bool value);
+
+    /**
+     * Return the value of a bit.
+     *
+     * @param   idx
+     *          The index of the bit.
+     *
+     * @return  The value of the bit.
+     */
+    bool get(std::size_t idx) const;
+
+    /**
+     * Encode the values of some binary variables of a solution, i.e., the bit
+     * k is set if and only if the value of the variable indexes[k] is greater
+     * than 0.5. The vector is resized to the number of indexes.
+     *
+     * @param   values
+     *          Values assigned to each variable of the problem.
+     * @param   indexes
+     *          Indexes of the (binary) variables to encode.
+     */
+    void encode(const IloNumArray& values, const std::vector<std::size_t>& indexes);
+
+    /**
+     * Return the number of bits set.
+     *
+     * @return  The number of bits set.
+     */
+    std::size_t count() const;
+
+    /**
+     * Check whether this vector agrees with another one on the bits of a mask,
+     * i.e., if ((this XOR other) AND mask) has no bit set. All vectors must
+     * have the same size.
+     *
+     * @param   other
+     *          The other vector.
+     * @param   mask
+     *          The mask of bits compared.
+     *
+     * @return  True if the vectors agree on the bits of the mask, false
+     *          otherwise.
+     */
+    bool agrees(const BitVector& other, const BitVector& mask) const;
+
+    /**
+     * Return the number of bits set in ((this XOR other) AND mask), i.e., the
+     * Hamming distance between the vectors regarding the bits of a mask. All
+     * vectors must have the same size.
+     *
+     * @param   other
+     *          The other vector.
+     * @param   mask
+     *          The mask of bits compared.
+     *
+     * @return  The number of bits of the mask in which the vectors differ.
+     */
+    std::size_t distance(const BitVector& other, const BitVector& mask) const;
+
+    /**
+     * Return the words that store the bits (bit k is the bit k % 64 of the
+     * word k / 64; the unused bits of the last word are zero).
+     *
+     * @return  A pointer to the first of num_words() words.
+     */
+    const std::uint64_t* words() const;
+    std::uint64_t* words();
+
+    /**
+     * Return the number of words that store the bits.
+     *
+     * @return  The number of words.
+     */
+    std::size_t num_words() const;
+
+private:
+
+    std::size_t size_;
+    std::vector<std::uint64_t> words_;
+
+    static constexpr std::size_t WORD_BITS = 64;
+};
+
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include "checkpoint.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <sstream>
+#include <unistd.h>
+
+
+namespace {
+
+/*
+ * Identification of the file format.
+ */
+constexpr char MAGIC[8] = {'O', 'R', 'C', 'S', 'C', 'K', 'P', 'T'};
+constexpr std::uint32_t VERSION = 1;
+
+template <typename T>
+void write_raw(std::FILE* file, const T* data, std::size_t count, bool& ok) {
+    if (ok && count > 0) {
+        ok = (std::fwrite(data, sizeof(T), count, file) == count);
+    }
+}
+
+template <typename T>
+void read_raw(std::FILE* file, T* data, std::size_t count) {
+    if (count > 0 && std::fread(data, sizeof(T), count, file) != count) {
+        throw std::string("Invalid checkpoint file (truncated).");
+    }
+}
+
+}
+
+void orcs::Checkpoint::write(const std::string& filename) const {
+
+    // Write into a temporary file, which replaces the checkpoint only when it
+    // is complete (and flushed to disk)
+    std::string temporary = filename + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::string("Invalid checkpoint file (it cannot be written).");
+    }
+
+    bool ok = true;
+    std::int32_t phase32 = phase;
+    std::int64_t nodes64 = nodes;
+    std::int64_t before_nodes64 = before_nodes;
+    std::uint64_t num_entries = solutions.size();
+    std::uint64_t num_variables = (solutions.empty() ? 0 : solutions.front().size());
+    std::uint64_t state_size = heuristic_state.size();
+
+    write_raw(file, MAGIC, sizeof(MAGIC), ok);
+    write_raw(file, &VERSION, 1, ok);
+    write_raw(file, &phase32, 1, ok);
+    write_raw(file, &elapsed, 1, ok);
+    write_raw(file, &nodes64, 1, ok);
+    write_raw(file, &before_runtime, 1, ok);
+    write_raw(file, &before_nodes64, 1, ok);
+    write_raw(file, &num_entries, 1, ok);
+    write_raw(file, &num_variables, 1, ok);
+    for (std::size_t e = 0; e < solutions.size(); ++e) {
+        write_raw(file, &objectives[e], 1, ok);
+        write_raw(file, solutions[e].data(), solutions[e].size(), ok);
+    }
+    write_raw(file, &state_size, 1, ok);
+    write_raw(file, heuristic_state.data(), heuristic_state.size(), ok);
+
+    ok = ok && (std::fflush(file) == 0) && (fsync(fileno(file)) == 0);
+    ok = (std::fclose(file) == 0) && ok;
+
+    if (!ok || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::string("Invalid checkpoint file (it cannot be written).");
+    }
+}
+
+void orcs::Checkpoint::read(const std::string& filename, std::size_t num_variables) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::string("Invalid checkpoint file (it cannot be read).");
+    }
+
+    try {
+        char magic[sizeof(MAGIC)];
+        std::uint32_t version;
+        read_raw(file, magic, sizeof(MAGIC));
+        read_raw(file, &version, 1);
+        if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+            throw std::string("Invalid checkpoint file (unknown format).");
+        }
+
+        std::int32_t phase32;
+        std::int64_t nodes64;
+        std::int64_t before_nodes64;
+        std::uint64_t num_entries;
+        std::uint64_t entry_size;
+        read_raw(file, &phase32, 1);
+        read_raw(file, &elapsed, 1);
+        read_raw(file, &nodes64, 1);
+        read_raw(file, &before_runtime, 1);
+        read_raw(file, &before_nodes64, 1);
+        read_raw(file, &num_entries, 1);
+        read_raw(file, &entry_size, 1);
+        if ((phase32 != 1 && phase32 != 2) || (num_entries > 0 && entry_size != num_variables)) {
+            throw std::string("Invalid checkpoint file (it does not match the problem).");
+        }
+
+        phase = phase32;
+        nodes = nodes64;
+        before_nodes = before_nodes64;
+
+        solutions.assign(num_entries, std::vector<double>(entry_size));
+        objectives.assign(num_entries, 0.0);
+        for (std::size_t e = 0; e < num_entries; ++e) {
+            read_raw(file, &objectives[e], 1);
+            read_raw(file, solutions[e].data(), entry_size);
+        }
+
+        std::uint64_t state_size;
+        read_raw(file, &state_size, 1);
+        heuristic_state.assign(state_size, '\0');
+        read_raw(file, &heuristic_state[0], state_size);
+
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+
+    std::fclose(file);
+}
+
+orcs::Checkpointer::Checkpointer(const std::string& filename, double interval,
+        const SolutionPool* pool, const cxxtimer::Timer* timer, double time_offset,
+        long long nodes_offset) :
+        filename_(filename), interval_(interval), last_checkpoint_(time_offset),
+        pool_(pool), heuristic_(nullptr), timer_(timer), time_offset_(time_offset),
+        nodes_offset_(nodes_offset), phase_(1), before_runtime_(0.0), before_nodes_(0),
+        writing_(false)
+{
+    // It does nothing here.
+}
+
+orcs::Checkpointer::~Checkpointer() {
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+void orcs::Checkpointer::set_phase(int phase, double before_runtime, long long before_nodes,
+        const Heuristic* heuristic) {
+    phase_ = phase;
+    before_runtime_ = before_runtime;
+    before_nodes_ = before_nodes;
+    heuristic_ = heuristic;
+}
+
+void orcs::Checkpointer::poll(long long nodes) {
+
+    // Check if it is time to take a checkpoint (and the last one is done)
+    double elapsed = time_offset_ + timer_->count<std::chrono::milliseconds>() / 1000.0;
+    if (elapsed - last_checkpoint_ < interval_ || writing_) {
+        return;
+    }
+
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    last_checkpoint_ = elapsed;
+
+    // Take the snapshot
+    Checkpoint checkpoint;
+    checkpoint.phase = phase_;
+    checkpoint.elapsed = elapsed;
+    checkpoint.nodes = nodes_offset_ + nodes;
+    checkpoint.before_runtime = before_runtime_;
+    checkpoint.before_nodes = before_nodes_;
+
+    for (const auto& entry : pool_->get_entries()) {
+        std::vector<double> solution(entry.solution.getSize());
+        for (std::size_t j = 0; j < solution.size(); ++j) {
+            solution[j] = entry.solution[j];
+        }
+        checkpoint.solutions.push_back(std::move(solution));
+        checkpoint.objectives.push_back(entry.value);
+    }
+
+    if (heuristic_ != nullptr) {
+        std::ostringstream state;
+        heuristic_->write_state(state);
+        checkpoint.heuristic_state = state.str();
+    }
+
+    // Write it in the background (if it fails, the previous checkpoint is
+    // kept and the next one is tried at the next interval)
+    writing_ = true;
+    writer_ = std::thread([this, checkpoint = std::move(checkpoint)]() {
+        try {
+            checkpoint.write(filename_);
+        } catch (...) {
+            // It does nothing here.
+        }
+        writing_ = false;
+    });
+}
@@ -0,0 +1,172 @@
+#ifndef ORCS_CHECKPOINT_H
+#define ORCS_CHECKPOINT_H
+
+#include "solution_pool.h"
+#include "heuristic.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * Snapshot of the optimization process, used to resume a run interrupted
+ * (e.g., by the preemption of the machine) without losing its progress: the
+ * entries of the pool of solutions, the state of the heuristic and the time
+ * and MIP nodes spent so far.
+ *
+ * Checkpoints are written in a compact binary format (values are written as
+ * they are in memory, so a checkpoint must be read on the same architecture).
+ * A checkpoint is written into a temporary file that replaces the previous
+ * one only when it is complete, so a run killed while writing a checkpoint
+ * still has the previous one.
+ */
+struct Checkpoint {
+
+    /*
+     * Phase of the optimization process (1: before the heuristic, 2: using
+     * the heuristic), time (in seconds) and MIP nodes spent so far, and the
+     * ones spent by the 1st phase (only meaningful in the 2nd phase).
+     */
+    int phase = 1;
+    double elapsed = 0.0;
+    long long nodes = 0;
+    double before_runtime = 0.0;
+    long long before_nodes = 0;
+
+    /*
+     * Entries of the pool of solutions (values of the variables and value of
+     * the objective function of each solution).
+     */
+    std::vector<std::vector<double>> solutions;
+    std::vector<double> objectives;
+
+    /*
+     * State of the heuristic (as written by Heuristic::write_state).
+     */
+    std::string heuristic_state;
+
+    /**
+     * Write the checkpoint into a file. It replaces the file atomically.
+     *
+     * @param   filename
+     *          Path to the file of the checkpoint.
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Read a checkpoint from a file.
+     *
+     * @param   filename
+     *          Path to the file of the checkpoint.
+     * @param   num_variables
+     *          The number of variables of the problem (checkpoints of other
+     *          problems are rejected).
+     */
+    void read(const std::string& filename, std::size_t num_variables);
+};
+
+/**
+ * This class takes periodic checkpoints of the optimization process. The
+ * snapshot is taken by the thread that polls the checkpointer (the CPLEX
+ * thread, so it does not race with the callbacks that change the pool and the
+ * heuristic), but it is written to disk by a background thread, so the
+ * optimization does not wait for the file system. If the previous checkpoint
+ * is still being written, a new one is skipped.
+ */
+class Checkpointer {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   filename
+     *          Path to the file of the checkpoints.
+     * @param   interval
+     *          Time (in seconds) between checkpoints.
+     * @param   pool
+     *          Pointer to the pool of solutions.
+     * @param   timer
+     *          The timer to get the elapsed time of this run.
+     * @param   time_offset
+     *          Time (in seconds) spent before this run (by the runs it
+     *          resumes).
+     * @param   nodes_offset
+     *          MIP nodes explored before this run.
+     */
+    Checkpointer(const std::string& filename, double interval, const SolutionPool* pool,
+            const cxxtimer::Timer* timer, double time_offset = 0.0, long long nodes_offset = 0);
+
+    /**
+     * Set the phase of the optimization process.
+     *
+     * @param   phase
+     *          The phase (1: before the heuristic, 2: using the heuristic).
+     * @param   before_runtime
+     *          The time (in seconds, including the offset) spent by the 1st
+     *          phase.
+     * @param   before_nodes
+     *          The MIP nodes (including the offset) explored by the 1st phase.
+     * @param   heuristic
+     *          Pointer to the heuristic (or nullptr, if there is not any).
+     */
+    void set_phase(int phase, double before_runtime = 0.0, long long before_nodes = 0,
+            const Heuristic* heuristic = nullptr);
+
+    /**
+     * Take a checkpoint, if the interval since the last one has elapsed.
+     *
+     * @param   nodes
+     *          The MIP nodes explored by this run.
+     */
+    void poll(long long nodes);
+
+    /**
+     * Destructor. It waits for the checkpoint being written, if any.
+     */
+    virtual ~Checkpointer();
+
+    Checkpointer(const Checkpointer& other) = delete;
+    Checkpointer(Checkpointer&& other) = delete;
+    Checkpointer& operator=(const Checkpointer& other) = delete;
+    Checkpointer& operator=(Checkpointer&& other) = delete;
+
+private:
+
+    /*
+     * Destination and frequency of the checkpoints.
+     */
+    std::string filename_;
+    double interval_;
+    double last_checkpoint_;
+
+    /*
+     * State of the optimization process.
+     */
+    const SolutionPool* pool_;
+    const Heuristic* heuristic_;
+    const cxxtimer::Timer* timer_;
+    double time_offset_;
+    long long nodes_offset_;
+    int phase_;
+    double before_runtime_;
+    long long before_nodes_;
+
+    /*
+     * Background writer.
+     */
+    std::thread writer_;
+    std::atomic<bool> writing_;
+};
+
+}
+
+#endif
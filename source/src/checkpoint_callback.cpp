@@ -0,0 +1,21 @@
+#include "checkpoint_callback.h"
+
+
+IloCplex::Callback orcs::CheckpointCallback::create_instance(IloEnv& env,
+        orcs::Checkpointer* checkpointer) {
+    return (IloCplex::Callback(new (env) orcs::CheckpointCallback(env, checkpointer)));
+}
+
+orcs::CheckpointCallback::CheckpointCallback(IloEnv& env, orcs::Checkpointer* checkpointer) :
+    IloCplex::NodeCallbackI(env), checkpointer_(checkpointer)
+{
+    // It does nothing here.
+}
+
+IloCplex::CallbackI* orcs::CheckpointCallback::duplicateCallback() const {
+    return (new (getEnv()) orcs::CheckpointCallback(*this));
+}
+
+void orcs::CheckpointCallback::main() {
+    checkpointer_->poll(getNnodes64());
+}
@@ -0,0 +1,61 @@
+#ifndef ORCS_CHECKPOINT_CALLBACK_H
+#define ORCS_CHECKPOINT_CALLBACK_H
+
+
+#include "checkpoint.h"
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+
+/**
+ * Callback class used to take periodic checkpoints throughout the
+ * optimization process. It is a node callback (the MIP info callback is used
+ * by the stopping criteria), but it does not select nodes: CPLEX keeps its
+ * own node selection.
+ */
+class CheckpointCallback : public IloCplex::NodeCallbackI {
+
+public:
+
+    /**
+     * This static method creates a new instance of this class and returns a
+     * handle for the instance.
+     *
+     * @param   env
+     *          CPLEX environment.
+     * @param   checkpointer
+     *          The checkpointer polled at each node.
+     */
+    static IloCplex::Callback create_instance(IloEnv& env, Checkpointer* checkpointer);
+
+protected:
+
+    /**
+     * Constructor is made protected. For creating an instance, you should call
+     * the static method create_instance(...).
+     *
+     * @param   env
+     *          CPLEX environment.
+     * @param   checkpointer
+     *          The checkpointer polled at each node.
+     */
+    CheckpointCallback(IloEnv& env, Checkpointer* checkpointer);
+
+    IloCplex::CallbackI* duplicateCallback() const override;
+
+    void main() override;
+
+private:
+
+    Checkpointer* checkpointer_;
+
+};
+
+}
+
+
+#endif
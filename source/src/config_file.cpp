@@ -0,0 +1,185 @@
+#include "config_file.h"
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+
+
+namespace {
+
+/*
+ * Remove the leading and trailing white spaces of a string.
+ */
+std::string trim(const std::string& text) {
+    std::size_t begin = 0;
+    std::size_t end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        --end;
+    }
+
+    return text.substr(begin, end - begin);
+}
+
+/*
+ * Remove the comment (if any) of a line, ignoring '#' inside strings.
+ */
+std::string strip_comment(const std::string& line) {
+    bool quoted = false;
+    for (std::size_t k = 0; k < line.size(); ++k) {
+        if (line[k] == '\\' && quoted) {
+            ++k;
+        } else if (line[k] == '"') {
+            quoted = !quoted;
+        } else if (line[k] == '#' && !quoted) {
+            return line.substr(0, k);
+        }
+    }
+
+    return line;
+}
+
+/*
+ * Return whether a key (or a table name) has only valid characters.
+ */
+bool valid_key(const std::string& key) {
+    return !key.empty() && std::all_of(key.begin(), key.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+    });
+}
+
+}
+
+const std::vector<std::string> orcs::ConfigFile::PREFIXED_TABLES = {"maravilha", "rothberg", "submip"};
+
+orcs::ConfigFile::ConfigFile(const std::string& filename) {
+
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::string("Unable to read the configuration file " + filename + ".");
+    }
+
+    // Current table: the parameter set (if any) and the prefix of its keys
+    std::map<std::string, Value>* target = &values_;
+    std::string prefix;
+
+    std::string line;
+    for (std::size_t number = 1; std::getline(file, line); ++number) {
+        std::string error = "Invalid configuration file " + filename + " (line " + std::to_string(number) + ").";
+        line = trim(strip_comment(line));
+        if (line.empty()) {
+            continue;
+        }
+
+        // Table header
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                throw error;
+            }
+
+            std::vector<std::string> names;
+            std::string name = trim(line.substr(1, line.size() - 2));
+            for (std::size_t begin = 0, end; begin <= name.size(); begin = end + 1) {
+                end = std::min(name.find('.', begin), name.size());
+                names.push_back(trim(name.substr(begin, end - begin)));
+                if (!valid_key(names.back())) {
+                    throw error;
+                }
+            }
+
+            target = &values_;
+            if (names[0] == "sets" && names.size() >= 2) {
+                target = &sets_[names[1]];
+                names.erase(names.begin(), names.begin() + 2);
+            }
+
+            prefix.clear();
+            if (names.size() == 1 &&
+                    std::find(PREFIXED_TABLES.begin(), PREFIXED_TABLES.end(), names[0]) != PREFIXED_TABLES.end()) {
+                prefix = names[0] + "-";
+            } else if (!names.empty()) {
+                throw error;
+            }
+
+            continue;
+        }
+
+        // Key-value pair
+        std::size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            throw error;
+        }
+
+        std::string key = trim(line.substr(0, equal));
+        std::string text = trim(line.substr(equal + 1));
+        if (!valid_key(key) || text.empty()) {
+            throw error;
+        }
+
+        Value value;
+        value.flag = false;
+        if (text.front() == '"') {
+
+            // String (with escaped quotes and backslashes)
+            if (text.size() < 2 || text.back() != '"') {
+                throw error;
+            }
+            for (std::size_t k = 1; k + 1 < text.size(); ++k) {
+                if (text[k] == '\\') {
+                    if (++k + 1 >= text.size()) {
+                        throw error;
+                    }
+                } else if (text[k] == '"') {
+                    throw error;
+                }
+                value.text.push_back(text[k]);
+            }
+
+        } else if (text == "true" || text == "false") {
+
+            // Boolean (flag)
+            value.flag = true;
+            value.text = text;
+
+        } else {
+
+            // Number
+            char* end = nullptr;
+            std::strtod(text.c_str(), &end);
+            if (end == text.c_str() || *end != '\0') {
+                throw error;
+            }
+            value.text = text;
+        }
+
+        (*target)[prefix + key] = value;
+    }
+}
+
+std::vector<std::string> orcs::ConfigFile::arguments(const std::string& set) const {
+
+    // Top-level values overridden by the parameter set
+    std::map<std::string, Value> values(values_);
+    if (!set.empty()) {
+        auto it = sets_.find(set);
+        if (it == sets_.end()) {
+            throw std::string("Parameter set not found in the configuration file: " + set + ".");
+        }
+
+        for (const auto& value : it->second) {
+            values[value.first] = value.second;
+        }
+    }
+
+    std::vector<std::string> args;
+    for (const auto& value : values) {
+        if (!value.second.flag) {
+            args.push_back("--" + value.first + "=" + value.second.text);
+        } else if (value.second.text == "true") {
+            args.push_back("--" + value.first);
+        }
+    }
+
+    return args;
+}
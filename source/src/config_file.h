@@ -0,0 +1,89 @@
+#ifndef ORCS_CONFIG_FILE_H
+#define ORCS_CONFIG_FILE_H
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace orcs {
+
+/**
+ * This class reads a configuration file with values of command line options,
+ * which allows tuned configurations to be deployed as files instead of long
+ * command lines. The file is written in a subset of TOML:
+ *
+ *     # Comments start with '#'
+ *     heuristic = "rothberg"
+ *     seed = 7
+ *     submip-split-components = true
+ *
+ *     [rothberg]
+ *     mutations = 30              # same as rothberg-mutations = 30
+ *
+ *     [sets.fast]                 # a named parameter set
+ *     submip-nodes-limit = 200
+ *
+ *     [sets.fast.rothberg]
+ *     recombinations = 10
+ *
+ * Keys are the long names of the command line options. Keys in the tables
+ * [maravilha], [rothberg] and [submip] are prefixed by the name of the table.
+ * Values are strings (in double quotes), numbers or booleans; a boolean sets
+ * (true) or leaves unset (false) a flag. Tables [sets.NAME] (and their
+ * [sets.NAME.TABLE] subtables) define named parameter sets, which override
+ * the top-level values when selected.
+ */
+class ConfigFile {
+
+public:
+
+    /**
+     * Constructor. It reads and parses a configuration file. It throws an
+     * error message (std::string) if the file can not be read or has a syntax
+     * error.
+     *
+     * @param   filename
+     *          Path to the configuration file.
+     */
+    explicit ConfigFile(const std::string& filename);
+
+    /**
+     * Return the command line arguments equivalent to the top-level values of
+     * the file, overridden by the values of a parameter set (if any). It
+     * throws an error message (std::string) if the parameter set is not
+     * defined in the file.
+     *
+     * @param   set
+     *          Name of the parameter set (or empty, for no parameter set).
+     *
+     * @return  The command line arguments.
+     */
+    std::vector<std::string> arguments(const std::string& set = "") const;
+
+private:
+
+    /**
+     * A value of an option. Flags are options whose value is a boolean.
+     */
+    struct Value {
+        std::string text;
+        bool flag;
+    };
+
+    /*
+     * Top-level values and values of each parameter set (by option name).
+     */
+    std::map<std::string, Value> values_;
+    std::map<std::string, std::map<std::string, Value>> sets_;
+
+    /*
+     * Tables whose keys are prefixed by the name of the table.
+     */
+    static const std::vector<std::string> PREFIXED_TABLES;
+};
+
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include "constraint_graph.h"
+#include <unordered_map>
+
+
+orcs::ConstraintGraph::ConstraintGraph(const ProblemData& problem) :
+        objective_coefs_(problem.variables.getSize(), 0.0), objective_constant_(0.0),
+        maximize_(problem.objective.getSense() == IloObjective::Maximize)
+{
+    std::size_t num_variables = problem.variables.getSize();
+    std::size_t num_constraints = problem.constraints.getSize();
+
+    // Map CPLEX variables to their indexes (and keep their bounds and types)
+    std::unordered_map<IloInt, std::size_t> index;
+    index.reserve(num_variables);
+    column_lb_.reserve(num_variables);
+    column_ub_.reserve(num_variables);
+    column_integer_.reserve(num_variables);
+    for (std::size_t j = 0; j < num_variables; ++j) {
+        index[problem.variables[j].getId()] = j;
+        column_lb_.push_back(problem.variables[j].getLB());
+        column_ub_.push_back(problem.variables[j].getUB());
+        column_integer_.push_back(problem.variables[j].getType() != IloNumVar::Type::Float);
+    }
+
+    // Objective function
+    IloExpr objective(problem.objective.getExpr());
+    for (IloExpr::LinearIterator it = objective.getLinearIterator(); it.ok(); ++it) {
+        objective_coefs_[index[it.getVar().getId()]] += it.getCoef();
+    }
+    objective_constant_ = objective.getConstant();
+
+    // Constraint matrix (CSR)
+    row_start_.reserve(num_constraints + 1);
+    row_lb_.reserve(num_constraints);
+    row_ub_.reserve(num_constraints);
+    row_start_.push_back(0);
+
+    for (std::size_t i = 0; i < num_constraints; ++i) {
+        IloExpr expr(problem.constraints[i].getExpr());
+        for (IloExpr::LinearIterator it = expr.getLinearIterator(); it.ok(); ++it) {
+            row_variables_.push_back(index[it.getVar().getId()]);
+            row_coefs_.push_back(it.getCoef());
+        }
+
+        row_start_.push_back(row_variables_.size());
+        row_lb_.push_back(problem.constraints[i].getLB() - expr.getConstant());
+        row_ub_.push_back(problem.constraints[i].getUB() - expr.getConstant());
+    }
+
+    // Transpose of the constraint matrix (CSC)
+    column_start_.assign(num_variables + 1, 0);
+    for (auto j : row_variables_) {
+        ++column_start_[j + 1];
+    }
+
+    for (std::size_t j = 0; j < num_variables; ++j) {
+        column_start_[j + 1] += column_start_[j];
+    }
+
+    std::vector<std::size_t> position(column_start_.begin(), column_start_.end() - 1);
+    column_constraints_.resize(row_variables_.size());
+    column_coefs_.resize(row_variables_.size());
+    for (std::size_t i = 0; i < num_constraints; ++i) {
+        for (std::size_t k = row_start_[i]; k < row_start_[i + 1]; ++k) {
+            std::size_t p = position[row_variables_[k]]++;
+            column_constraints_[p] = i;
+            column_coefs_[p] = row_coefs_[k];
+        }
+    }
+}
+
+std::size_t orcs::ConstraintGraph::num_variables() const {
+    return objective_coefs_.size();
+}
+
+std::size_t orcs::ConstraintGraph::num_constraints() const {
+    return row_lb_.size();
+}
+
+std::size_t orcs::ConstraintGraph::row_size(std::size_t row) const {
+    return row_start_[row + 1] - row_start_[row];
+}
+
+const std::size_t* orcs::ConstraintGraph::row_variables(std::size_t row) const {
+    return row_variables_.data() + row_start_[row];
+}
+
+const double* orcs::ConstraintGraph::row_coefs(std::size_t row) const {
+    return row_coefs_.data() + row_start_[row];
+}
+
+double orcs::ConstraintGraph::row_lb(std::size_t row) const {
+    return row_lb_[row];
+}
+
+double orcs::ConstraintGraph::row_ub(std::size_t row) const {
+    return row_ub_[row];
+}
+
+std::size_t orcs::ConstraintGraph::column_size(std::size_t column) const {
+    return column_start_[column + 1] - column_start_[column];
+}
+
+const std::size_t* orcs::ConstraintGraph::column_constraints(std::size_t column) const {
+    return column_constraints_.data() + column_start_[column];
+}
+
+const double* orcs::ConstraintGraph::column_coefs(std::size_t column) const {
+    return column_coefs_.data() + column_start_[column];
+}
+
+double orcs::ConstraintGraph::objective_coef(std::size_t column) const {
+    return objective_coefs_[column];
+}
+
+double orcs::ConstraintGraph::objective_constant() const {
+    return objective_constant_;
+}
+
+bool orcs::ConstraintGraph::maximize() const {
+    return maximize_;
+}
+
+double orcs::ConstraintGraph::column_lb(std::size_t column) const {
+    return column_lb_[column];
+}
+
+double orcs::ConstraintGraph::column_ub(std::size_t column) const {
+    return column_ub_[column];
+}
+
+bool orcs::ConstraintGraph::column_integer(std::size_t column) const {
+    return column_integer_[column];
+}
+
+double orcs::ConstraintGraph::evaluate(const IloNumArray& solution) const {
+    double value = objective_constant_;
+    for (std::size_t j = 0; j < objective_coefs_.size(); ++j) {
+        value += objective_coefs_[j] * solution[j];
+    }
+
+    return value;
+}
+
+std::size_t orcs::ConstraintGraph::components(const std::vector<bool>& selected,
+        std::vector<std::size_t>& component) const {
+
+    std::size_t n = num_variables();
+
+    // Union-find structure (union by size and path halving)
+    std::vector<std::size_t> parent(n);
+    std::vector<std::size_t> size(n, 1);
+    for (std::size_t j = 0; j < n; ++j) {
+        parent[j] = j;
+    }
+
+    auto find = [&parent](std::size_t j) {
+        while (parent[j] != j) {
+            parent[j] = parent[parent[j]];
+            j = parent[j];
+        }
+        return j;
+    };
+
+    // Join the selected variables of each constraint
+    for (std::size_t i = 0; i < num_constraints(); ++i) {
+        std::size_t first = n;
+        for (std::size_t k = row_start_[i]; k < row_start_[i + 1]; ++k) {
+            std::size_t j = row_variables_[k];
+            if (!selected[j]) {
+                continue;
+            }
+
+            if (first == n) {
+                first = find(j);
+                continue;
+            }
+
+            std::size_t root = find(j);
+            if (root != first) {
+                if (size[root] > size[first]) {
+                    std::swap(root, first);
+                }
+                parent[root] = first;
+                size[first] += size[root];
+            }
+        }
+    }
+
+    // Number the components
+    std::size_t count = 0;
+    std::vector<std::size_t> label(n, n);
+    component.assign(n, n);
+    for (std::size_t j = 0; j < n; ++j) {
+        if (selected[j]) {
+            std::size_t root = find(j);
+            if (label[root] == n) {
+                label[root] = count++;
+            }
+            component[j] = label[root];
+        }
+    }
+
+    return count;
+}
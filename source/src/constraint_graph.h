@@ -0,0 +1,251 @@
+#ifndef ORCS_CONSTRAINT_GRAPH_H
+#define ORCS_CONSTRAINT_GRAPH_H
+
+#include "problem_data.h"
+#include "placement.h"
+#include <cstdlib>
+#include <vector>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class keeps the coefficient matrix of the (linear) constraints of an
+ * optimization problem in compressed sparse row (CSR) format, as well as its
+ * transpose (compressed sparse column format), the bounds of the constraints
+ * and the coefficients of the objective function, as well as the bounds (at
+ * construction) and the types of the variables. It describes the bipartite
+ * variable-constraint graph of the problem, where a variable and a constraint
+ * are adjacent if the variable has a non-zero coefficient in the constraint.
+ */
+class ConstraintGraph {
+
+public:
+
+    /**
+     * Constructor. It builds the graph from the model of a problem.
+     *
+     * @param   problem
+     *          Problem data.
+     */
+    explicit ConstraintGraph(const ProblemData& problem);
+
+    /**
+     * Return the number of variables.
+     *
+     * @return  The number of variables.
+     */
+    std::size_t num_variables() const;
+
+    /**
+     * Return the number of constraints.
+     *
+     * @return  The number of constraints.
+     */
+    std::size_t num_constraints() const;
+
+    /**
+     * Return the number of variables with non-zero coefficients in a
+     * constraint.
+     *
+     * @param   row
+     *          Index of the constraint.
+     *
+     * @return  The number of non-zero coefficients of the constraint.
+     */
+    std::size_t row_size(std::size_t row) const;
+
+    /**
+     * Return the indexes of the variables with non-zero coefficients in a
+     * constraint.
+     *
+     * @param   row
+     *          Index of the constraint.
+     *
+     * @return  A pointer to the first of row_size(row) variable indexes.
+     */
+    const std::size_t* row_variables(std::size_t row) const;
+
+    /**
+     * Return the non-zero coefficients of a constraint.
+     *
+     * @param   row
+     *          Index of the constraint.
+     *
+     * @return  A pointer to the first of row_size(row) coefficients.
+     */
+    const double* row_coefs(std::size_t row) const;
+
+    /**
+     * Return the lower bound (left-hand side) of a constraint.
+     *
+     * @param   row
+     *          Index of the constraint.
+     *
+     * @return  The lower bound of the constraint.
+     */
+    double row_lb(std::size_t row) const;
+
+    /**
+     * Return the upper bound (right-hand side) of a constraint.
+     *
+     * @param   row
+     *          Index of the constraint.
+     *
+     * @return  The upper bound of the constraint.
+     */
+    double row_ub(std::size_t row) const;
+
+    /**
+     * Return the number of constraints in which a variable has a non-zero
+     * coefficient.
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  The number of non-zero coefficients of the variable.
+     */
+    std::size_t column_size(std::size_t column) const;
+
+    /**
+     * Return the indexes of the constraints in which a variable has a
+     * non-zero coefficient.
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  A pointer to the first of column_size(column) constraint
+     *          indexes.
+     */
+    const std::size_t* column_constraints(std::size_t column) const;
+
+    /**
+     * Return the non-zero coefficients of a variable.
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  A pointer to the first of column_size(column) coefficients.
+     */
+    const double* column_coefs(std::size_t column) const;
+
+    /**
+     * Return the coefficient of a variable in the objective function.
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  The objective coefficient of the variable.
+     */
+    double objective_coef(std::size_t column) const;
+
+    /**
+     * Return the constant term of the objective function.
+     *
+     * @return  The constant term of the objective function.
+     */
+    double objective_constant() const;
+
+    /**
+     * Return whether the objective function is maximized.
+     *
+     * @return  True for maximization problems, false for minimization ones.
+     */
+    bool maximize() const;
+
+    /**
+     * Return the lower bound of a variable (when the graph was built).
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  The lower bound of the variable.
+     */
+    double column_lb(std::size_t column) const;
+
+    /**
+     * Return the upper bound of a variable (when the graph was built).
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  The upper bound of the variable.
+     */
+    double column_ub(std::size_t column) const;
+
+    /**
+     * Return whether a variable is integer (or binary).
+     *
+     * @param   column
+     *          Index of the variable.
+     *
+     * @return  True if the variable is integer, false otherwise.
+     */
+    bool column_integer(std::size_t column) const;
+
+    /**
+     * Evaluate the objective function of a solution.
+     *
+     * @param   solution
+     *          Values assigned to each variable of the problem.
+     *
+     * @return  The value of the objective function.
+     */
+    double evaluate(const IloNumArray& solution) const;
+
+    /**
+     * Find the connected components of the graph induced by a subset of the
+     * variables (two variables are connected if they have non-zero
+     * coefficients in a same constraint). Components are found by union-find.
+     *
+     * @param   selected
+     *          Flags indicating the variables to consider.
+     * @param   component
+     *          Output vector with the component of each variable. Variables
+     *          not selected are assigned to component num_variables().
+     *
+     * @return  The number of components.
+     */
+    std::size_t components(const std::vector<bool>& selected,
+            std::vector<std::size_t>& component) const;
+
+private:
+
+    /*
+     * Constraint matrix in CSR format (the largest arrays may be backed by
+     * huge pages).
+     */
+    std::vector<std::size_t> row_start_;
+    std::vector<std::size_t, HugePageAllocator<std::size_t>> row_variables_;
+    std::vector<double, HugePageAllocator<double>> row_coefs_;
+    std::vector<double> row_lb_;
+    std::vector<double> row_ub_;
+
+    /*
+     * Constraint matrix in CSC format.
+     */
+    std::vector<std::size_t> column_start_;
+    std::vector<std::size_t, HugePageAllocator<std::size_t>> column_constraints_;
+    std::vector<double, HugePageAllocator<double>> column_coefs_;
+
+    /*
+     * Objective function.
+     */
+    std::vector<double> objective_coefs_;
+    double objective_constant_;
+    bool maximize_;
+
+    /*
+     * Variables.
+     */
+    std::vector<double> column_lb_;
+    std::vector<double> column_ub_;
+    std::vector<bool> column_integer_;
+};
+
+}
+
+#endif
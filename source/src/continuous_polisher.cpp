@@ -0,0 +1,75 @@
+#include "continuous_polisher.h"
+#include <cmath>
+
+
+orcs::ContinuousPolisher::ContinuousPolisher(const std::string& filename) :
+        problem_(filename), values_(problem_.env, problem_.variables.getSize())
+{
+    // Integer variables (fixed by each solution to polish) and continuous ones
+    std::size_t n = (std::size_t) problem_.variables.getSize();
+    for (std::size_t j = 0; j < n; ++j) {
+        if (problem_.variables[j].getType() != IloNumVar::Type::Float) {
+            integer_variables_.push_back(j);
+        } else {
+            continuous_variables_.push_back(j);
+        }
+    }
+    fixed_values_.assign(integer_variables_.size(), std::numeric_limits<double>::quiet_NaN());
+
+    // Relax the integer variables (the model becomes an LP)
+    conversion_ = IloConversion(problem_.env, problem_.variables, IloNumVar::Type::Float);
+    problem_.model.add(conversion_);
+
+    problem_.cplex.setOut(problem_.env.getNullStream());
+    problem_.cplex.setWarning(problem_.env.getNullStream());
+    problem_.cplex.setError(problem_.env.getNullStream());
+    problem_.cplex.setParam(IloCplex::Param::Threads, 1);
+}
+
+orcs::ContinuousPolisher::~ContinuousPolisher() {
+    values_.end();
+}
+
+bool orcs::ContinuousPolisher::polish(IloNumArray& solution, IloNum& objective,
+        const cxxtimer::Timer* timer, double time_limit) {
+
+    // Fix the integer variables to their values in the solution (only the
+    // bounds that changed are updated, so the LP is warm started)
+    for (std::size_t k = 0; k < integer_variables_.size(); ++k) {
+        double value = std::round(solution[integer_variables_[k]]);
+        if (value != fixed_values_[k]) {
+            problem_.variables[integer_variables_[k]].setBounds(value, value);
+            fixed_values_[k] = value;
+        }
+    }
+
+    // Solve the LP within the remaining time
+    double remaining_time = time_limit;
+    if (timer != nullptr) {
+        remaining_time -= timer->count<std::chrono::milliseconds>() / 1000.0;
+    }
+
+    if (remaining_time <= 0.0) {
+        return false;
+    }
+
+    problem_.cplex.setParam(IloCplex::Param::TimeLimit, std::min(remaining_time, 1e75));
+    if (!problem_.cplex.solve() || problem_.cplex.getStatus() != IloAlgorithm::Status::Optimal) {
+        return false;
+    }
+
+    // Keep the continuous completion, if it improves the solution
+    IloNum value = problem_.cplex.getObjValue();
+    bool improved = (problem_.objective.getSense() == IloObjective::Minimize ?
+            value < objective - THRESHOLD : value > objective + THRESHOLD);
+
+    if (improved) {
+        problem_.cplex.getValues(values_, problem_.variables);
+        for (auto j : continuous_variables_) {
+            solution[j] = values_[j];
+        }
+        objective = value;
+    }
+
+    return improved;
+}
@@ -0,0 +1,86 @@
+#ifndef ORCS_CONTINUOUS_POLISHER_H
+#define ORCS_CONTINUOUS_POLISHER_H
+
+#include "problem_data.h"
+#include <cstdlib>
+#include <vector>
+#include <limits>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class polishes the continuous part of solutions of mixed problems: it
+ * fixes the integer variables of a solution and solves the LP that remains,
+ * which gives the best continuous values for that integer assignment.
+ *
+ * The LP is persistent: it keeps its own copy of the problem (in its own CPLEX
+ * environment) with the integer variables relaxed, and only the bounds of the
+ * integer variables whose values changed are updated from one solution to
+ * another, so each LP is warm started from the basis of the previous one.
+ */
+class ContinuousPolisher {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   filename
+     *          Path to the file of the problem.
+     */
+    explicit ContinuousPolisher(const std::string& filename);
+
+    /**
+     * Polish the continuous part of a solution. The solution (and its value)
+     * is replaced only if the LP improves it.
+     *
+     * @param   solution
+     *          Values assigned to each variable of the problem.
+     * @param   objective
+     *          The value of the objective function of the solution.
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     * @param   time_limit
+     *          The time limit of the optimization process (in seconds).
+     *
+     * @return  True if the solution was improved, false otherwise.
+     */
+    bool polish(IloNumArray& solution, IloNum& objective,
+            const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max());
+
+    /**
+     * Destructor.
+     */
+    virtual ~ContinuousPolisher();
+
+    ContinuousPolisher(const ContinuousPolisher& other) = delete;
+    ContinuousPolisher(ContinuousPolisher&& other) = delete;
+    ContinuousPolisher& operator=(const ContinuousPolisher& other) = delete;
+    ContinuousPolisher& operator=(ContinuousPolisher&& other) = delete;
+
+private:
+
+    /*
+     * Copy of the problem (with integer variables relaxed) and the current
+     * bounds of its integer variables.
+     */
+    ProblemData problem_;
+    IloConversion conversion_;
+    std::vector<std::size_t> integer_variables_;
+    std::vector<std::size_t> continuous_variables_;
+    std::vector<double> fixed_values_;
+    IloNumArray values_;
+
+    static constexpr double THRESHOLD = 1e-5;
+};
+
+}
+
+#endif
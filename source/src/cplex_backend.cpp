@@ -0,0 +1,134 @@
+#include "cplex_backend.h"
+
+
+orcs::CplexBackend::CplexBackend(const std::string& filename,
+        const SubmipParameters& params) :
+        env_(), data_(nullptr), extracted_(false),
+        status_(IloAlgorithm::Status::Unknown), objective_(0.0)
+{
+    // Load its own copy of the problem
+    data_ = new ProblemData(env_, filename);
+
+    std::size_t n = data_->variables.getSize();
+    lb_.resize(n);
+    ub_.resize(n);
+    solution_.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        lb_[j] = data_->variables[j].getLB();
+        ub_[j] = data_->variables[j].getUB();
+    }
+
+    // Parameters
+    nodes_unsuccessful_ = params.nodes_unsuccessful;
+    stall_ = params.stall;
+
+    // Set CPLEX instance used to solve sub-MIPs
+    env_.setOut(env_.getNullStream());
+    env_.setWarning(env_.getNullStream());
+    env_.setError(env_.getNullStream());
+    data_->cplex.setOut(env_.getNullStream());
+    data_->cplex.setWarning(env_.getNullStream());
+    data_->cplex.setError(env_.getNullStream());
+    data_->cplex.setParam(IloCplex::Param::Threads, 1);
+    data_->cplex.setParam(IloCplex::Param::RandomSeed, params.seed);
+    data_->cplex.setParam(IloCplex::Param::MIP::Limits::Nodes, params.nodes_limit);
+    data_->cplex.setParam(IloCplex::Param::MIP::Strategy::HeuristicFreq, 0);
+    data_->cplex.setParam(IloCplex::Param::MIP::Strategy::RINSHeur, 0);
+    data_->cplex.setParam(IloCplex::Param::MIP::Strategy::LBHeur, false);
+}
+
+orcs::CplexBackend::~CplexBackend() {
+    delete data_;
+    env_.end();
+}
+
+void orcs::CplexBackend::set_bounds(std::size_t idx, double lb, double ub) {
+    if (lb_[idx] != lb || ub_[idx] != ub) {
+
+        // Unextract the model before changing it (faster than updating the
+        // extracted model bound by bound)
+        if (extracted_) {
+            data_->cplex.clear();
+            extracted_ = false;
+        }
+
+        data_->variables[idx].setBounds(lb, ub);
+        lb_[idx] = lb;
+        ub_[idx] = ub;
+    }
+}
+
+void orcs::CplexBackend::set_start(const std::vector<double>& start) {
+    start_ = start;
+}
+
+bool orcs::CplexBackend::solve(const cxxtimer::Timer* timer, double time_limit) {
+
+    // Unextract previous model in CPLEX solver (it also removes the previous
+    // MIP starts and callbacks)
+    if (extracted_) {
+        data_->cplex.clear();
+    }
+
+    // Extract sub-MIP model into CPLEX solver
+    data_->cplex.extract(data_->model);
+    extracted_ = true;
+
+    // Set a MIP start solution
+    if (!start_.empty()) {
+        IloNumArray start_solution(env_, start_.size());
+        for (std::size_t j = 0; j < start_.size(); ++j) {
+            start_solution[j] = start_[j];
+        }
+        data_->cplex.addMIPStart(data_->variables, start_solution);
+        start_solution.end();
+        start_.clear();
+    }
+
+    // Set sub-MIP abort callback
+    data_->cplex.use(orcs::AbortCallback::create_instance(env_, timer,
+            time_limit, std::numeric_limits<unsigned long long>::max(),
+            nodes_unsuccessful_, data_->objective.getSense(),
+            std::numeric_limits<double>::quiet_NaN(), stall_));
+
+    // Optimize the sub-MIP
+    bool found = data_->cplex.solve();
+    status_ = data_->cplex.getStatus();
+
+    if (found) {
+        objective_ = data_->cplex.getObjValue();
+        IloNumArray values(env_, solution_.size());
+        data_->cplex.getValues(values, data_->variables);
+        for (std::size_t j = 0; j < solution_.size(); ++j) {
+            solution_[j] = values[j];
+        }
+        values.end();
+    }
+
+    return found;
+}
+
+orcs::SubmipStatus orcs::CplexBackend::status() const {
+    return convert(status_);
+}
+
+orcs::SubmipStatus orcs::CplexBackend::convert(IloAlgorithm::Status status) {
+    switch (status) {
+        case IloAlgorithm::Status::Optimal:
+            return SubmipStatus::OPTIMAL;
+        case IloAlgorithm::Status::Infeasible:
+            return SubmipStatus::INFEASIBLE;
+        case IloAlgorithm::Status::Feasible:
+            return SubmipStatus::FEASIBLE;
+        default:
+            return SubmipStatus::UNKNOWN;
+    }
+}
+
+double orcs::CplexBackend::objective() const {
+    return objective_;
+}
+
+const std::vector<double>& orcs::CplexBackend::solution() const {
+    return solution_;
+}
@@ -0,0 +1,96 @@
+#ifndef ORCS_CPLEX_BACKEND_H
+#define ORCS_CPLEX_BACKEND_H
+
+#include "submip_backend.h"
+#include "problem_data.h"
+#include "abort_callback.h"
+#include "parameters.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * Sub-MIP backend based on CPLEX. Since CPLEX environments are not thread
+ * safe, each backend keeps its own environment with its own copy of the
+ * problem.
+ */
+class CplexBackend : public SubmipBackend {
+
+public:
+
+    /**
+     * Constructor. It loads its own copy of the problem.
+     *
+     * @param   filename
+     *          Path to file containing the optimization problem.
+     * @param   params
+     *          The sub-MIP parameters.
+     */
+    CplexBackend(const std::string& filename, const SubmipParameters& params);
+
+    /**
+     * Destructor.
+     */
+    virtual ~CplexBackend();
+
+    void set_bounds(std::size_t idx, double lb, double ub) override;
+    void set_start(const std::vector<double>& start) override;
+    bool solve(const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max()) override;
+    SubmipStatus status() const override;
+    double objective() const override;
+    const std::vector<double>& solution() const override;
+
+    /**
+     * Return the status of a sub-MIP corresponding to a status of CPLEX.
+     *
+     * @param   status
+     *          The status of CPLEX.
+     *
+     * @return  The status of the sub-MIP.
+     */
+    static SubmipStatus convert(IloAlgorithm::Status status);
+
+    CplexBackend(const CplexBackend& other) = delete;
+    CplexBackend(CplexBackend&& other) = delete;
+    CplexBackend& operator=(const CplexBackend& other) = delete;
+    CplexBackend& operator=(CplexBackend&& other) = delete;
+
+private:
+
+    IloEnv env_;
+    ProblemData* data_;
+    bool extracted_;
+
+    /*
+     * Current bounds of the variables (used to avoid redundant updates) and
+     * the MIP start of the next solve.
+     */
+    std::vector<double> lb_;
+    std::vector<double> ub_;
+    std::vector<double> start_;
+
+    /*
+     * Result of the last solve.
+     */
+    IloAlgorithm::Status status_;
+    double objective_;
+    std::vector<double> solution_;
+
+    /*
+     * Parameters.
+     */
+    long nodes_unsuccessful_;
+    StallCriterion stall_;
+};
+
+}
+
+#endif
@@ -0,0 +1,530 @@
+#include "fix_and_propagate.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+
+orcs::FixAndPropagate::FixAndPropagate(ProblemData* problem, const ConstructiveParameters& params) :
+        problem_(problem), graph_(*problem), has_continuous_(false), max_candidates_(0),
+        start_time_(0.0),
+        params_(params), placement_(params.placement)
+{
+    for (std::size_t j = 0; j < graph_.num_variables(); ++j) {
+        if (graph_.column_integer(j)) {
+            integer_variables_.push_back(j);
+        } else {
+            has_continuous_ = true;
+        }
+    }
+}
+
+std::size_t orcs::FixAndPropagate::run(const cxxtimer::Timer* timer) {
+    max_candidates_ = params_.candidates;
+    return search(params_.attempts, nullptr, timer);
+}
+
+std::size_t orcs::FixAndPropagate::run(const std::vector<std::vector<double>>& hints,
+        const cxxtimer::Timer* timer) {
+    max_candidates_ = hints.size();
+    return search(hints.size(), &hints, timer);
+}
+
+std::size_t orcs::FixAndPropagate::search(std::size_t num_attempts,
+        const std::vector<std::vector<double>>* hints, const cxxtimer::Timer* timer) {
+
+    solutions_.clear();
+    objectives_.clear();
+    candidates_.clear();
+    start_time_ = (timer != nullptr ? timer->count<std::chrono::milliseconds>() / 1000.0 : 0.0);
+
+    if (num_attempts == 0) {
+        return 0;
+    }
+
+    // Propagate all constraints once (every attempt starts from the result)
+    std::size_t n = graph_.num_variables();
+    std::size_t m = graph_.num_constraints();
+    State root;
+    root.lb.resize(n);
+    root.ub.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        root.lb[j] = graph_.column_lb(j);
+        root.ub[j] = graph_.column_ub(j);
+    }
+    root.queued.assign(m, 1);
+    for (std::size_t i = 0; i < m; ++i) {
+        root.queue.push_back(i);
+    }
+
+    if (!propagate(root)) {
+        return 0;
+    }
+
+    root_lb_.swap(root.lb);
+    root_ub_.swap(root.ub);
+
+    // The LP relaxation guides the fixings (but the ones guided by hints)
+    relaxation_.clear();
+    if (hints == nullptr && params_.order == ConstructiveParameters::Order::RELAXATION) {
+        solve_relaxation();
+    }
+
+    // Run the attempts in parallel
+    std::atomic<std::size_t> next_attempt(0);
+    std::vector<std::exception_ptr> errors(params_.threads);
+    std::vector<std::thread> threads;
+    for (long t = 0; t < params_.threads; ++t) {
+        threads.emplace_back([&, t]() {
+            try {
+                placement_.pin_worker(t);
+                State state;
+                std::size_t index;
+                while ((index = next_attempt++) < num_attempts && remaining_time(timer) > 0.0) {
+                    attempt(index, state, (hints != nullptr ? &(*hints)[index] : nullptr));
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Complete (or repair) the best candidates
+    std::sort(candidates_.begin(), candidates_.end(),
+            [](const Candidate& a, const Candidate& b) {
+                return (a.num_conflicts != b.num_conflicts ?
+                        a.num_conflicts < b.num_conflicts : a.estimate < b.estimate);
+            });
+
+    for (const auto& candidate : candidates_) {
+        if (remaining_time(timer) <= 0.0) {
+            break;
+        }
+
+        if (!complete(candidate)) {
+            repair(candidate, timer);
+        }
+    }
+
+    return solutions_.size();
+}
+
+const std::vector<std::vector<double>>& orcs::FixAndPropagate::solutions() const {
+    return solutions_;
+}
+
+const std::vector<double>& orcs::FixAndPropagate::objectives() const {
+    return objectives_;
+}
+
+void orcs::FixAndPropagate::attempt(std::size_t index, State& state,
+        const std::vector<double>* hint) {
+
+    std::size_t n = graph_.num_variables();
+    std::mt19937 random(params_.seed + index);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double sense = (graph_.maximize() ? -1.0 : 1.0);
+
+    // Start from the propagated bounds
+    state.lb = root_lb_;
+    state.ub = root_ub_;
+    state.conflict.assign(n, 0);
+    state.queued.assign(graph_.num_constraints(), 0);
+    state.queue.clear();
+
+    // Order of the fixings (the one of the variables, if guided by a hint, the
+    // most integral variables in the relaxation first or a random one)
+    std::vector<std::size_t> order(integer_variables_);
+    bool guided = !relaxation_.empty();
+    if (hint != nullptr) {
+        // Keep the order of the variables
+    } else if (guided) {
+        std::vector<std::pair<double, std::size_t>> keys;
+        keys.reserve(order.size());
+        for (auto j : order) {
+            double fractionality = std::abs(relaxation_[j] - std::round(relaxation_[j]));
+            keys.emplace_back(fractionality + (index > 0 ? 0.1 * uniform(random) : 0.0), j);
+        }
+        std::sort(keys.begin(), keys.end());
+        for (std::size_t k = 0; k < keys.size(); ++k) {
+            order[k] = keys[k].second;
+        }
+    } else {
+        std::shuffle(order.begin(), order.end(), random);
+    }
+
+    // Fix the variables one at a time
+    std::size_t num_conflicts = 0;
+    for (auto j : order) {
+
+        // Skip variables already fixed by the propagation
+        if (state.ub[j] - state.lb[j] < 0.5) {
+            continue;
+        }
+
+        // Value of the hint (variables without values are left free), of the
+        // relaxation (rounded) or bound preferred by the objective
+        double value;
+        if (hint != nullptr) {
+            if (std::isnan((*hint)[j])) {
+                state.conflict[j] = 1;
+                ++num_conflicts;
+                continue;
+            }
+            value = std::round((*hint)[j]);
+        } else if (guided) {
+            value = (index == 0 ? std::round(relaxation_[j]) : std::floor(relaxation_[j] + uniform(random)));
+        } else {
+            double coef = sense * graph_.objective_coef(j);
+            bool at_lb = (coef > 0.0 || (coef == 0.0 && uniform(random) < 0.5));
+            value = (at_lb ? state.lb[j] : state.ub[j]);
+            if (std::abs(value) >= INFINITE_BOUND) {
+                value = (at_lb ? state.ub[j] : state.lb[j]);
+            }
+            if (std::abs(value) >= INFINITE_BOUND) {
+                value = 0.0;
+            }
+        }
+        value = std::max(state.lb[j], std::min(state.ub[j], value));
+
+        // Fix the variable (or to its other value, if the fixing fails and it
+        // is not guided by a hint)
+        if (!fix(state, j, value)) {
+            double other = (value - 1.0 >= state.lb[j] ? value - 1.0 : value + 1.0);
+            if (hint != nullptr || other > state.ub[j] || !fix(state, j, other)) {
+                state.conflict[j] = 1;
+                ++num_conflicts;
+            }
+        }
+    }
+
+    // Build the candidate
+    Candidate candidate;
+    candidate.values.assign(n, 0.0);
+    candidate.conflict = state.conflict;
+    candidate.num_conflicts = num_conflicts;
+    candidate.estimate = 0.0;
+    for (auto j : integer_variables_) {
+        if (!state.conflict[j]) {
+            candidate.values[j] = state.lb[j];
+            candidate.estimate += sense * graph_.objective_coef(j) * state.lb[j];
+        }
+    }
+
+    // Keep the candidate, if it is among the best ones (and it is new)
+    std::lock_guard<std::mutex> lock(candidates_mutex_);
+    std::size_t worst = 0;
+    for (std::size_t c = 0; c < candidates_.size(); ++c) {
+        if (candidates_[c].num_conflicts == candidate.num_conflicts &&
+                candidates_[c].values == candidate.values) {
+            return;
+        }
+
+        if (candidates_[c].num_conflicts > candidates_[worst].num_conflicts ||
+                (candidates_[c].num_conflicts == candidates_[worst].num_conflicts &&
+                 candidates_[c].estimate > candidates_[worst].estimate)) {
+            worst = c;
+        }
+    }
+
+    if (candidates_.size() < max_candidates_) {
+        candidates_.push_back(std::move(candidate));
+    } else if (!candidates_.empty() &&
+            (candidate.num_conflicts < candidates_[worst].num_conflicts ||
+             (candidate.num_conflicts == candidates_[worst].num_conflicts &&
+              candidate.estimate < candidates_[worst].estimate))) {
+        candidates_[worst] = std::move(candidate);
+    }
+}
+
+bool orcs::FixAndPropagate::fix(State& state, std::size_t column, double value) const {
+
+    // Only the changes of this fixing can be undone
+    state.trail_columns.clear();
+    state.trail_lb.clear();
+    state.trail_ub.clear();
+
+    change_bounds(state, column, value, value);
+    if (propagate(state)) {
+        return true;
+    }
+
+    // Undo the fixing and the bounds it implied
+    for (std::size_t k = state.trail_columns.size(); k > 0; --k) {
+        state.lb[state.trail_columns[k - 1]] = state.trail_lb[k - 1];
+        state.ub[state.trail_columns[k - 1]] = state.trail_ub[k - 1];
+    }
+
+    return false;
+}
+
+void orcs::FixAndPropagate::change_bounds(State& state, std::size_t column, double lb, double ub) const {
+    state.trail_columns.push_back(column);
+    state.trail_lb.push_back(state.lb[column]);
+    state.trail_ub.push_back(state.ub[column]);
+    state.lb[column] = lb;
+    state.ub[column] = ub;
+
+    const std::size_t* rows = graph_.column_constraints(column);
+    for (std::size_t k = 0; k < graph_.column_size(column); ++k) {
+        if (!state.queued[rows[k]]) {
+            state.queued[rows[k]] = 1;
+            state.queue.push_back(rows[k]);
+        }
+    }
+}
+
+bool orcs::FixAndPropagate::propagate(State& state) const {
+
+    bool feasible = true;
+    std::size_t visits = 0;
+
+    while (feasible && !state.queue.empty() && visits++ < PROPAGATION_LIMIT) {
+        std::size_t row = state.queue.back();
+        state.queue.pop_back();
+        state.queued[row] = 0;
+
+        std::size_t size = graph_.row_size(row);
+        const std::size_t* columns = graph_.row_variables(row);
+        const double* coefs = graph_.row_coefs(row);
+        double row_lb = graph_.row_lb(row);
+        double row_ub = graph_.row_ub(row);
+        bool has_lb = (row_lb > -INFINITE_BOUND);
+        bool has_ub = (row_ub < INFINITE_BOUND);
+
+        // Minimum and maximum activities of the constraint (finite parts and
+        // number of infinite contributions)
+        double min_activity = 0.0;
+        double max_activity = 0.0;
+        std::size_t min_infinite = 0;
+        std::size_t max_infinite = 0;
+        for (std::size_t k = 0; k < size; ++k) {
+            double lb = state.lb[columns[k]];
+            double ub = state.ub[columns[k]];
+            double low = (coefs[k] > 0.0 ? lb : ub);
+            double high = (coefs[k] > 0.0 ? ub : lb);
+
+            if (std::abs(low) >= INFINITE_BOUND) {
+                ++min_infinite;
+            } else {
+                min_activity += coefs[k] * low;
+            }
+
+            if (std::abs(high) >= INFINITE_BOUND) {
+                ++max_infinite;
+            } else {
+                max_activity += coefs[k] * high;
+            }
+        }
+
+        // Check whether the constraint can be satisfied
+        if ((has_ub && min_infinite == 0 && min_activity > row_ub + THRESHOLD * (1.0 + std::abs(row_ub))) ||
+                (has_lb && max_infinite == 0 && max_activity < row_lb - THRESHOLD * (1.0 + std::abs(row_lb)))) {
+            feasible = false;
+            break;
+        }
+
+        // Tighten the bounds of the free integer variables
+        for (std::size_t k = 0; k < size; ++k) {
+            std::size_t j = columns[k];
+            if (!graph_.column_integer(j) || state.ub[j] - state.lb[j] < 0.5) {
+                continue;
+            }
+
+            double low = (coefs[k] > 0.0 ? state.lb[j] : state.ub[j]);
+            double high = (coefs[k] > 0.0 ? state.ub[j] : state.lb[j]);
+            bool low_infinite = (std::abs(low) >= INFINITE_BOUND);
+            bool high_infinite = (std::abs(high) >= INFINITE_BOUND);
+
+            // Activities of the other variables of the constraint
+            bool residual_min_finite = (min_infinite == (low_infinite ? 1 : 0));
+            bool residual_max_finite = (max_infinite == (high_infinite ? 1 : 0));
+            double residual_min = min_activity - (low_infinite ? 0.0 : coefs[k] * low);
+            double residual_max = max_activity - (high_infinite ? 0.0 : coefs[k] * high);
+
+            double lb = state.lb[j];
+            double ub = state.ub[j];
+            if (has_ub && residual_min_finite) {
+                double bound = (row_ub - residual_min) / coefs[k];
+                if (coefs[k] > 0.0) {
+                    ub = std::min(ub, std::floor(bound + THRESHOLD));
+                } else {
+                    lb = std::max(lb, std::ceil(bound - THRESHOLD));
+                }
+            }
+
+            if (has_lb && residual_max_finite) {
+                double bound = (row_lb - residual_max) / coefs[k];
+                if (coefs[k] > 0.0) {
+                    lb = std::max(lb, std::ceil(bound - THRESHOLD));
+                } else {
+                    ub = std::min(ub, std::floor(bound + THRESHOLD));
+                }
+            }
+
+            if (lb > ub + 0.5) {
+                feasible = false;
+                break;
+            }
+
+            if (lb > state.lb[j] + 0.5 || ub < state.ub[j] - 0.5) {
+                change_bounds(state, j, lb, ub);
+            }
+        }
+    }
+
+    // Discard the constraints still queued (after a conflict or when the
+    // propagation limit is reached)
+    for (auto row : state.queue) {
+        state.queued[row] = 0;
+    }
+    state.queue.clear();
+
+    return feasible;
+}
+
+bool orcs::FixAndPropagate::complete(const Candidate& candidate) {
+
+    if (candidate.num_conflicts > 0 || has_continuous_) {
+        return false;
+    }
+
+    // Check every constraint (all variables are fixed)
+    for (std::size_t i = 0; i < graph_.num_constraints(); ++i) {
+        double activity = 0.0;
+        const std::size_t* columns = graph_.row_variables(i);
+        const double* coefs = graph_.row_coefs(i);
+        for (std::size_t k = 0; k < graph_.row_size(i); ++k) {
+            activity += coefs[k] * candidate.values[columns[k]];
+        }
+
+        if (activity < graph_.row_lb(i) - THRESHOLD * (1.0 + std::abs(graph_.row_lb(i))) ||
+                activity > graph_.row_ub(i) + THRESHOLD * (1.0 + std::abs(graph_.row_ub(i)))) {
+            return false;
+        }
+    }
+
+    double objective = graph_.objective_constant();
+    for (std::size_t j = 0; j < graph_.num_variables(); ++j) {
+        objective += graph_.objective_coef(j) * candidate.values[j];
+    }
+
+    solutions_.push_back(candidate.values);
+    objectives_.push_back(objective);
+
+    return true;
+}
+
+bool orcs::FixAndPropagate::repair(const Candidate& candidate, const cxxtimer::Timer* timer) {
+
+    std::size_t n = graph_.num_variables();
+
+    // Release the variables in conflict and their neighbors
+    std::vector<char> released(candidate.conflict);
+    for (auto j : integer_variables_) {
+        if (candidate.conflict[j]) {
+            const std::size_t* rows = graph_.column_constraints(j);
+            for (std::size_t k = 0; k < graph_.column_size(j); ++k) {
+                const std::size_t* columns = graph_.row_variables(rows[k]);
+                for (std::size_t l = 0; l < graph_.row_size(rows[k]); ++l) {
+                    released[columns[l]] = 1;
+                }
+            }
+        }
+    }
+
+    // Sub-MIP: the problem with the other integer variables fixed
+    IloModel submip(problem_->env);
+    submip.add(problem_->model);
+    IloRangeArray fixings(problem_->env);
+    for (auto j : integer_variables_) {
+        if (!released[j]) {
+            fixings.add(IloRange(problem_->env, candidate.values[j], problem_->variables[j],
+                    candidate.values[j]));
+        }
+    }
+    submip.add(fixings);
+
+    IloCplex cplex(problem_->env);
+    cplex.setOut(problem_->env.getNullStream());
+    cplex.setWarning(problem_->env.getNullStream());
+    cplex.setError(problem_->env.getNullStream());
+    cplex.setParam(IloCplex::Param::Threads, 1);
+    cplex.setParam(IloCplex::Param::RandomSeed, params_.seed);
+    cplex.setParam(IloCplex::Param::MIP::Limits::Nodes, params_.repair_nodes);
+    cplex.setParam(IloCplex::Param::TimeLimit, std::max(0.0, remaining_time(timer)));
+    cplex.extract(submip);
+
+    bool found = cplex.solve();
+    if (found) {
+        IloNumArray values(problem_->env, n);
+        cplex.getValues(values, problem_->variables);
+        solutions_.emplace_back(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            solutions_.back()[j] = values[j];
+        }
+        objectives_.push_back(cplex.getObjValue());
+        values.end();
+    }
+
+    // Free resources
+    cplex.end();
+    fixings.endElements();
+    fixings.end();
+    submip.end();
+
+    return found;
+}
+
+void orcs::FixAndPropagate::solve_relaxation() {
+
+    // LP relaxation of the problem
+    IloModel relaxation(problem_->env);
+    relaxation.add(problem_->model);
+    IloConversion conversion(problem_->env, problem_->variables, IloNumVar::Type::Float);
+    relaxation.add(conversion);
+
+    IloCplex cplex(problem_->env);
+    cplex.setOut(problem_->env.getNullStream());
+    cplex.setWarning(problem_->env.getNullStream());
+    cplex.setError(problem_->env.getNullStream());
+    cplex.setParam(IloCplex::Param::Threads, 1);
+    cplex.setParam(IloCplex::Param::TimeLimit, params_.time_limit);
+    cplex.extract(relaxation);
+
+    // Keep the relaxed solution (the fixings follow a random order, if the LP
+    // is not solved)
+    if (cplex.solve()) {
+        IloNumArray values(problem_->env, problem_->variables.getSize());
+        cplex.getValues(values, problem_->variables);
+        relaxation_.resize(values.getSize());
+        for (std::size_t j = 0; j < relaxation_.size(); ++j) {
+            relaxation_[j] = values[j];
+        }
+        values.end();
+    }
+
+    // Free resources
+    cplex.end();
+    conversion.end();
+    relaxation.end();
+}
+
+double orcs::FixAndPropagate::remaining_time(const cxxtimer::Timer* timer) const {
+    if (timer == nullptr) {
+        return params_.time_limit;
+    }
+
+    return params_.time_limit - (timer->count<std::chrono::milliseconds>() / 1000.0 - start_time_);
+}
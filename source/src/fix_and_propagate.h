@@ -0,0 +1,226 @@
+#ifndef ORCS_FIX_AND_PROPAGATE_H
+#define ORCS_FIX_AND_PROPAGATE_H
+
+#include "problem_data.h"
+#include "constraint_graph.h"
+#include "placement.h"
+#include "parameters.h"
+#include <cstdlib>
+#include <vector>
+#include <random>
+#include <mutex>
+#include <limits>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class implements a fix-and-propagate constructive heuristic, used to
+ * find feasible solutions before the branch-and-cut finds any.
+ *
+ * Each attempt fixes the integer variables one at a time (in a random or an
+ * LP-guided order) and, after each fixing, propagates the bounds of the other
+ * integer variables through the constraints (kept in the CSR matrix of the
+ * variable-constraint graph). If a fixing leads to an infeasible constraint,
+ * it is undone and the variable is fixed to its other value; if both fail, the
+ * variable is left free (a conflict). Attempts run in parallel threads.
+ *
+ * The attempts with fewest conflicts are then completed: an attempt without
+ * conflicts and continuous variables is already a solution, while the others
+ * are repaired by a small sub-MIP in which the integer variables keep their
+ * values, but the conflicting ones and their neighbors (variables that share
+ * constraints with them).
+ */
+class FixAndPropagate {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   problem
+     *          Pointer to problem data.
+     * @param   params
+     *          The parameters of the constructive heuristic.
+     */
+    FixAndPropagate(ProblemData* problem, const ConstructiveParameters& params);
+
+    /**
+     * Run the attempts and complete (or repair) the best ones.
+     *
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     *
+     * @return  The number of feasible solutions found.
+     */
+    std::size_t run(const cxxtimer::Timer* timer = nullptr);
+
+    /**
+     * Repair solutions that may be infeasible or partial (e.g., solutions of
+     * a previous version of the problem). Each one guides an attempt: its
+     * integer variables are fixed to their values and propagated, the ones
+     * without values (or whose values conflict with the previous fixings) are
+     * left free, and the result is completed or repaired as any other attempt
+     * (all of them are kept as candidates).
+     *
+     * @param   hints
+     *          The values of the variables of each solution to repair (NaN
+     *          for the variables without values).
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     *
+     * @return  The number of feasible solutions found.
+     */
+    std::size_t run(const std::vector<std::vector<double>>& hints,
+            const cxxtimer::Timer* timer = nullptr);
+
+    /**
+     * Return the feasible solutions found by the last run.
+     *
+     * @return  The values assigned to each variable of the problem in each
+     *          solution found.
+     */
+    const std::vector<std::vector<double>>& solutions() const;
+
+    /**
+     * Return the values of the objective function of the feasible solutions
+     * found by the last run.
+     *
+     * @return  The value of the objective function of each solution found.
+     */
+    const std::vector<double>& objectives() const;
+
+    FixAndPropagate(const FixAndPropagate& other) = delete;
+    FixAndPropagate(FixAndPropagate&& other) = delete;
+    FixAndPropagate& operator=(const FixAndPropagate& other) = delete;
+    FixAndPropagate& operator=(FixAndPropagate&& other) = delete;
+
+private:
+
+    /*
+     * Domains of the variables along an attempt, the changes of the bounds
+     * since the last successful fixing (to undo a failed one) and the
+     * constraints waiting to be propagated.
+     */
+    struct State {
+        std::vector<double> lb;
+        std::vector<double> ub;
+        std::vector<char> conflict;
+        std::vector<std::size_t> trail_columns;
+        std::vector<double> trail_lb;
+        std::vector<double> trail_ub;
+        std::vector<std::size_t> queue;
+        std::vector<char> queued;
+    };
+
+    /*
+     * Result of an attempt: the values of the integer variables (the ones in
+     * conflict are free) and its ranking.
+     */
+    struct Candidate {
+        std::vector<double> values;
+        std::vector<char> conflict;
+        std::size_t num_conflicts;
+        double estimate;
+    };
+
+    /**
+     * Run a number of attempts (guided by hints, if any) and complete (or
+     * repair) the best candidates.
+     */
+    std::size_t search(std::size_t num_attempts, const std::vector<std::vector<double>>* hints,
+            const cxxtimer::Timer* timer);
+
+    /**
+     * Run an attempt (guided by a hint, if any) and keep it, if it is among
+     * the best candidates.
+     */
+    void attempt(std::size_t index, State& state, const std::vector<double>* hint);
+
+    /**
+     * Fix a variable and propagate the fixing. It returns false (and undoes
+     * the fixing) if it leads to an infeasible constraint.
+     */
+    bool fix(State& state, std::size_t column, double value) const;
+
+    /**
+     * Change the bounds of a variable (recording the previous ones) and
+     * enqueue its constraints.
+     */
+    void change_bounds(State& state, std::size_t column, double lb, double ub) const;
+
+    /**
+     * Propagate the queued constraints. It returns false if any of them is
+     * infeasible.
+     */
+    bool propagate(State& state) const;
+
+    /**
+     * Complete a candidate without conflicts and continuous variables. It
+     * returns false if the candidate is not a feasible solution.
+     */
+    bool complete(const Candidate& candidate);
+
+    /**
+     * Repair a candidate by a sub-MIP. It returns false if no feasible
+     * solution is found.
+     */
+    bool repair(const Candidate& candidate, const cxxtimer::Timer* timer);
+
+    /**
+     * Solve the LP relaxation of the problem (used to guide the fixings).
+     */
+    void solve_relaxation();
+
+    /**
+     * Return the remaining time of the heuristic (in seconds).
+     */
+    double remaining_time(const cxxtimer::Timer* timer) const;
+
+    /*
+     * Problem and its constraint matrix.
+     */
+    ProblemData* problem_;
+    ConstraintGraph graph_;
+    std::vector<std::size_t> integer_variables_;
+    bool has_continuous_;
+    std::vector<double> relaxation_;
+
+    /*
+     * Bounds of the variables after propagating all constraints (the start
+     * of every attempt).
+     */
+    std::vector<double> root_lb_;
+    std::vector<double> root_ub_;
+
+    /*
+     * Best candidates found by the attempts (shared by the threads) and the
+     * feasible solutions found.
+     */
+    std::mutex candidates_mutex_;
+    std::vector<Candidate> candidates_;
+    std::vector<std::vector<double>> solutions_;
+    std::vector<double> objectives_;
+    std::size_t max_candidates_;
+    double start_time_;
+
+    /*
+     * Parameters.
+     */
+    ConstructiveParameters params_;
+    Placement placement_;
+
+    static constexpr double THRESHOLD = 1e-5;
+    static constexpr double INFINITE_BOUND = 1e20;
+    static constexpr std::size_t PROPAGATION_LIMIT = 1000000;
+};
+
+}
+
+#endif
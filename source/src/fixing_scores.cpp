@@ -0,0 +1,163 @@
+#include "fixing_scores.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+
+orcs::FixingScores::Strategy orcs::FixingScores::parse_strategy(const std::string& name) {
+    if (name.compare("reduced-cost") == 0) {
+        return Strategy::REDUCED_COST;
+    } else if (name.compare("pseudo-cost") == 0) {
+        return Strategy::PSEUDO_COST;
+    } else if (name.compare("combined") == 0) {
+        return Strategy::COMBINED;
+    }
+
+    return Strategy::RANDOM;
+}
+
+orcs::FixingScores::FixingScores(ProblemData* problem, Strategy strategy,
+        std::size_t num_variables) :
+        problem_(problem), strategy_(strategy),
+        scores_(num_variables, 0.0),
+        reduced_costs_(num_variables, 0.0),
+        reduced_costs_ready_(false)
+{
+    // It does nothing here.
+}
+
+orcs::FixingScores::~FixingScores() {
+    if (reduced_costs_ready_) {
+        relaxation_cplex_.end();
+    }
+}
+
+orcs::FixingScores::Strategy orcs::FixingScores::strategy() const {
+    return strategy_;
+}
+
+void orcs::FixingScores::update(const HeuristicContext& context,
+        const IloNumArray& reference, const std::vector<std::size_t>& binary_variables) {
+
+    if (strategy_ == Strategy::RANDOM) {
+        return;
+    }
+
+    bool use_reduced_costs = (strategy_ == Strategy::REDUCED_COST || strategy_ == Strategy::COMBINED);
+    bool use_pseudo_costs = (strategy_ == Strategy::PSEUDO_COST || strategy_ == Strategy::COMBINED) &&
+            !context.down_pseudo_costs.empty() && !context.up_pseudo_costs.empty();
+
+    // Reduced costs come from the LP relaxation of the problem (solved only
+    // once, within the deadline of the heuristic)
+    if (use_reduced_costs && !reduced_costs_ready_) {
+        compute_reduced_costs(context.timer, context.time_limit);
+    }
+
+    // Cost of moving each variable away from its reference value
+    double sense = (problem_->objective.getSense() == IloObjective::Minimize ? 1.0 : -1.0);
+    std::vector<double> rc_costs(binary_variables.size(), 0.0);
+    std::vector<double> pc_costs(binary_variables.size(), 0.0);
+    double rc_max = 0.0;
+    double pc_max = 0.0;
+
+    for (std::size_t j = 0; j < binary_variables.size(); ++j) {
+        std::size_t idx = binary_variables[j];
+        bool at_one = (reference[idx] > 0.5);
+
+        if (use_reduced_costs) {
+            rc_costs[j] = std::max(0.0, sense * (at_one ? -reduced_costs_[idx] : reduced_costs_[idx]));
+            rc_max = std::max(rc_max, rc_costs[j]);
+        }
+
+        if (use_pseudo_costs) {
+            pc_costs[j] = std::max(0.0, (at_one ?
+                    context.down_pseudo_costs[idx] : context.up_pseudo_costs[idx]));
+            pc_max = std::max(pc_max, pc_costs[j]);
+        }
+    }
+
+    // Normalize and combine the scores
+    for (std::size_t j = 0; j < binary_variables.size(); ++j) {
+        double rc_score = (rc_max > 0.0 ? rc_costs[j] / rc_max : 0.0);
+        double pc_score = (pc_max > 0.0 ? pc_costs[j] / pc_max : 0.0);
+
+        switch (strategy_) {
+            case Strategy::REDUCED_COST:
+                scores_[binary_variables[j]] = rc_score;
+                break;
+            case Strategy::PSEUDO_COST:
+                scores_[binary_variables[j]] = pc_score;
+                break;
+            default:
+                scores_[binary_variables[j]] = (rc_score + pc_score) / 2.0;
+        }
+    }
+}
+
+double orcs::FixingScores::operator[](std::size_t idx) const {
+    return scores_[idx];
+}
+
+void orcs::FixingScores::order(std::vector<std::size_t>& variables, std::mt19937& random) const {
+
+    // Random keys of a weighted sampling without replacement (the higher the
+    // key, the earlier the variable is sampled)
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::pair<double, std::size_t>> keys;
+    keys.reserve(variables.size());
+    for (auto idx : variables) {
+        double u = 1.0 - uniform(random);
+        keys.emplace_back(std::log(u) / (MINIMUM_WEIGHT + scores_[idx]), idx);
+    }
+
+    std::sort(keys.begin(), keys.end(),
+            [](const std::pair<double, std::size_t>& a, const std::pair<double, std::size_t>& b) {
+                return a.first > b.first;
+            });
+
+    for (std::size_t j = 0; j < keys.size(); ++j) {
+        variables[j] = keys[j].second;
+    }
+}
+
+void orcs::FixingScores::compute_reduced_costs(const cxxtimer::Timer* timer, double time_limit) {
+
+    // Check timer (stop criterion): the reduced costs remain zero and the LP
+    // is solved in a later call
+    double remaining = time_limit;
+    if (timer != nullptr) {
+        remaining -= timer->count<std::chrono::milliseconds>() / 1000.0;
+    }
+
+    if (remaining <= 0.0) {
+        return;
+    }
+
+    // LP relaxation of the problem
+    relaxation_ = IloModel(problem_->env);
+    relaxation_.add(problem_->model);
+    relaxation_.add(IloConversion(problem_->env, problem_->variables, IloNumVar::Type::Float));
+
+    relaxation_cplex_ = IloCplex(problem_->env);
+    relaxation_cplex_.setOut(problem_->env.getNullStream());
+    relaxation_cplex_.setWarning(problem_->env.getNullStream());
+    relaxation_cplex_.setError(problem_->env.getNullStream());
+    relaxation_cplex_.setParam(IloCplex::Param::Threads, 1);
+    if (time_limit < std::numeric_limits<double>::max()) {
+        relaxation_cplex_.setParam(IloCplex::Param::TimeLimit, remaining);
+    }
+    relaxation_cplex_.extract(relaxation_);
+
+    // Keep the reduced costs (they remain zero if the LP is not solved)
+    if (relaxation_cplex_.solve()) {
+        IloNumArray reduced_costs(problem_->env, problem_->variables.getSize());
+        relaxation_cplex_.getReducedCosts(reduced_costs, problem_->variables);
+        for (std::size_t i = 0; i < reduced_costs_.size(); ++i) {
+            reduced_costs_[i] = reduced_costs[i];
+        }
+        reduced_costs.end();
+    }
+
+    reduced_costs_ready_ = true;
+}
@@ -0,0 +1,147 @@
+#ifndef ORCS_FIXING_SCORES_H
+#define ORCS_FIXING_SCORES_H
+
+#include "problem_data.h"
+#include "heuristic_context.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <random>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class scores how likely each binary variable is to keep its value in
+ * improving solutions, which is used by heuristics to choose the variables
+ * to fix when building sub-MIPs. A score is a value between 0 and 1 (the
+ * higher the score, the safer is fixing the variable). Scores are computed
+ * from the reduced costs of the LP relaxation of the problem and/or from the
+ * pseudo-costs of the branch-and-cut in which the heuristic is called, as
+ * given by the context of the heuristic.
+ */
+class FixingScores {
+
+public:
+
+    /**
+     * Strategies used to choose the variables to fix. RANDOM keeps the
+     * original (uniformly random) choice, REDUCED_COST uses the reduced costs
+     * of the LP relaxation, PSEUDO_COST uses the pseudo-costs of the
+     * branch-and-cut and COMBINED uses the average of both scores.
+     */
+    enum class Strategy { RANDOM, REDUCED_COST, PSEUDO_COST, COMBINED };
+
+    /**
+     * Return the strategy identified by a name (random, reduced-cost,
+     * pseudo-cost or combined). Unknown names return RANDOM.
+     *
+     * @param   name
+     *          Name of the strategy.
+     *
+     * @return  The strategy identified by the name.
+     */
+    static Strategy parse_strategy(const std::string& name);
+
+    /**
+     * Constructor. It does not access the problem (it may be built while the
+     * problem is being solved by another thread).
+     *
+     * @param   problem
+     *          Pointer to problem data.
+     * @param   strategy
+     *          The strategy used to score the variables.
+     * @param   num_variables
+     *          The number of variables of the problem.
+     */
+    FixingScores(ProblemData* problem, Strategy strategy, std::size_t num_variables);
+
+    /**
+     * Destructor.
+     */
+    virtual ~FixingScores();
+
+    /**
+     * Return the strategy used to score the variables.
+     *
+     * @return  The strategy used to score the variables.
+     */
+    Strategy strategy() const;
+
+    /**
+     * Update the scores of the binary variables regarding the values they
+     * would be fixed to.
+     *
+     * @param   context
+     *          The context of the heuristic, from which the pseudo-costs are
+     *          obtained (the reduced costs are the ones of the root LP
+     *          relaxation).
+     * @param   reference
+     *          The solution whose values the binary variables would be fixed
+     *          to.
+     * @param   binary_variables
+     *          Indexes of the binary variables to score.
+     */
+    void update(const HeuristicContext& context, const IloNumArray& reference,
+            const std::vector<std::size_t>& binary_variables);
+
+    /**
+     * Return the score of a variable.
+     *
+     * @param   idx
+     *          Index of the variable.
+     *
+     * @return  The score (between 0 and 1) of the variable.
+     */
+    double operator[](std::size_t idx) const;
+
+    /**
+     * Sort a set of variables in a random order biased by their scores, such
+     * that variables with higher scores tend to come first. Variables are
+     * ordered by weighted random sampling without replacement.
+     *
+     * @param   variables
+     *          Indexes of the variables to sort.
+     * @param   random
+     *          The random number generator.
+     */
+    void order(std::vector<std::size_t>& variables, std::mt19937& random) const;
+
+    FixingScores(const FixingScores& other) = delete;
+    FixingScores(FixingScores&& other) = delete;
+    FixingScores& operator=(const FixingScores& other) = delete;
+    FixingScores& operator=(FixingScores&& other) = delete;
+
+private:
+
+    /**
+     * Solve the LP relaxation of the problem (within a deadline) and keep the
+     * reduced costs of its binary variables.
+     */
+    void compute_reduced_costs(const cxxtimer::Timer* timer, double time_limit);
+
+    ProblemData* problem_;
+    Strategy strategy_;
+    std::vector<double> scores_;
+
+    /*
+     * LP relaxation of the problem and its reduced costs (computed once).
+     */
+    IloModel relaxation_;
+    IloCplex relaxation_cplex_;
+    std::vector<double> reduced_costs_;
+    bool reduced_costs_ready_;
+
+    /*
+     * Minimum weight of a variable when sorting by scores.
+     */
+    static constexpr double MINIMUM_WEIGHT = 1e-3;
+};
+
+}
+
+#endif
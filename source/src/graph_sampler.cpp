@@ -0,0 +1,89 @@
+#include "graph_sampler.h"
+#include <cmath>
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+
+namespace {
+
+// Status of a variable while growing a neighborhood
+constexpr char NOT_CANDIDATE = 0;
+constexpr char CANDIDATE = 1;
+constexpr char QUEUED = 2;
+constexpr char SELECTED = 3;
+
+}
+
+
+void orcs::GraphSampler::sample(const ConstraintGraph& graph,
+        const std::vector<std::size_t>& candidates, const std::vector<double>& weights,
+        std::size_t count, std::mt19937& random, std::vector<std::size_t>& selected) {
+
+    selected.clear();
+    count = std::min(count, candidates.size());
+
+    // Reset scratch data structures
+    keys_.resize(graph.num_variables());
+    status_.assign(graph.num_variables(), NOT_CANDIDATE);
+    row_expanded_.assign(graph.num_constraints(), 0);
+
+    // Random keys of a weighted sampling without replacement (the higher the
+    // key, the earlier the variable is sampled)
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::pair<double, std::size_t>> seeds;
+    seeds.reserve(candidates.size());
+    for (auto idx : candidates) {
+        keys_[idx] = std::log(1.0 - uniform(random)) / (MINIMUM_WEIGHT + weights[idx]);
+        status_[idx] = CANDIDATE;
+        seeds.emplace_back(keys_[idx], idx);
+    }
+
+    std::sort(seeds.begin(), seeds.end(),
+            [](const std::pair<double, std::size_t>& a, const std::pair<double, std::size_t>& b) {
+                return a.first > b.first;
+            });
+
+    // Grow the neighborhood along the constraints
+    std::priority_queue<std::pair<double, std::size_t>> frontier;
+    std::size_t next_seed = 0;
+
+    while (selected.size() < count) {
+
+        // Get the next variable: from the frontier of the current region or,
+        // if it is empty, a new seed
+        std::size_t idx;
+        if (!frontier.empty()) {
+            idx = frontier.top().second;
+            frontier.pop();
+        } else {
+            while (status_[seeds[next_seed].second] == SELECTED) {
+                ++next_seed;
+            }
+            idx = seeds[next_seed].second;
+        }
+
+        // Select the variable
+        status_[idx] = SELECTED;
+        selected.push_back(idx);
+
+        // Add to the frontier the candidates that share a constraint with it
+        // (each constraint is expanded only once)
+        const std::size_t* rows = graph.column_constraints(idx);
+        for (std::size_t k = 0; k < graph.column_size(idx); ++k) {
+            std::size_t row = rows[k];
+            if (row_expanded_[row]) {
+                continue;
+            }
+
+            row_expanded_[row] = 1;
+            const std::size_t* columns = graph.row_variables(row);
+            for (std::size_t p = 0; p < graph.row_size(row); ++p) {
+                if (status_[columns[p]] == CANDIDATE) {
+                    status_[columns[p]] = QUEUED;
+                    frontier.emplace(keys_[columns[p]], columns[p]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef ORCS_GRAPH_SAMPLER_H
+#define ORCS_GRAPH_SAMPLER_H
+
+#include "constraint_graph.h"
+#include <cstdlib>
+#include <vector>
+#include <random>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class samples sets of variables that are connected in the
+ * variable-constraint graph of a problem, such that the variables selected to
+ * be free in a sub-MIP share constraints and are able to move together.
+ *
+ * A neighborhood is grown from a seed variable by repeatedly selecting a
+ * variable adjacent (through a constraint) to the ones already selected. Both
+ * the seeds and the adjacent variables are chosen by weighted random sampling
+ * without replacement, so variables with higher weights tend to be selected
+ * first. A new seed is drawn whenever the current connected region has no
+ * more candidates to grow.
+ */
+class GraphSampler {
+
+public:
+
+    /**
+     * Select a set of variables from the candidate ones.
+     *
+     * @param   graph
+     *          The variable-constraint graph of the problem.
+     * @param   candidates
+     *          Indexes of the variables that can be selected.
+     * @param   weights
+     *          The weight of each variable of the problem (indexed by the
+     *          variable index).
+     * @param   count
+     *          Number of variables to select.
+     * @param   random
+     *          The random number generator.
+     * @param   selected
+     *          Output vector with the indexes of the selected variables.
+     */
+    void sample(const ConstraintGraph& graph, const std::vector<std::size_t>& candidates,
+            const std::vector<double>& weights, std::size_t count, std::mt19937& random,
+            std::vector<std::size_t>& selected);
+
+private:
+
+    /*
+     * Scratch data structures (reused among calls).
+     */
+    std::vector<double> keys_;
+    std::vector<char> status_;
+    std::vector<char> row_expanded_;
+
+    /*
+     * Minimum weight of a variable.
+     */
+    static constexpr double MINIMUM_WEIGHT = 1e-3;
+};
+
+}
+
+#endif
@@ -2,14 +2,31 @@
 #define ORCS_HEURISTIC_H
 
 
-#include <limits>
+#include "heuristic_context.h"
+#include <iostream>
 #include <ilcplex/ilocplex.h>
-#include <cxxtimer.hpp>
 
 ILOSTLBEGIN
 
 
 namespace orcs {
+
+/**
+ * Counters of the work done by a heuristic, used to measure its throughput.
+ */
+struct HeuristicStatistics {
+
+    /*
+     * Number of calls of the heuristic, of sub-MIPs solved (including the ones
+     * of nested heuristics and each component of split sub-MIPs), of calls
+     * that improved the incumbent solution and of neighborhoods skipped by the
+     * success predictor.
+     */
+    unsigned long long calls = 0;
+    unsigned long long submips = 0;
+    unsigned long long improvements = 0;
+    unsigned long long skipped = 0;
+};
     
 /**
  * Interface implemented by heuristics.
@@ -24,23 +41,48 @@ protected:
     static constexpr double THRESHOLD = 1e-5;
 
 public:
+
+    /**
+     * Destructor.
+     */
+    virtual ~Heuristic() {}
     
     /**
-     * This method must implement the heuristic method, which is called by
-     * the heuristic callback throughout the CPLEX's branch-and-cut.
+     * This method must implement the heuristic method. It is called by the
+     * heuristic callback throughout the CPLEX's branch-and-cut, but it does
+     * not depend on the callback: all data come from the context, and the
+     * best solution found must be handed to its solution sink.
      * 
-     * @param   callback
-     *          A pointer to the heuristic callback object from which this 
-     *          method is called.
-     * @param   timer
-     *          The timer to get the elapsed time spent on the entire
-     *          optimization process.
-     * @param   time_limit
-     *          The time limit of the optimization process (in seconds).
+     * @param   context
+     *          The incumbent solution, relaxation, pool of solutions, deadline
+     *          and solution sink of this call.
+     */
+    virtual void run(const HeuristicContext& context) = 0;
+
+    /**
+     * Return the counters of the work done by the heuristic so far.
+     *
+     * @return  The statistics of the heuristic.
+     */
+    virtual HeuristicStatistics statistics() const = 0;
+
+    /**
+     * Write the state the heuristic adapts along the search (e.g., the sizes
+     * of the sub-MIPs and the state of its random number generator), so that
+     * an interrupted run can be resumed from a checkpoint.
+     *
+     * @param   output
+     *          The stream to write the state.
+     */
+    virtual void write_state(std::ostream& output) const = 0;
+
+    /**
+     * Restore the state written by write_state.
+     *
+     * @param   input
+     *          The stream to read the state.
      */
-    virtual void run(IloCplex::HeuristicCallbackI* callback,
-                     const cxxtimer::Timer* timer = nullptr,
-                     double time_limit = std::numeric_limits<double>::max()) = 0;
+    virtual void read_state(std::istream& input) = 0;
 };
 
 }
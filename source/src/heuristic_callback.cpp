@@ -2,17 +2,19 @@
 
 
 IloCplex::Callback orcs::HeuristicCallback::create_instance(IloEnv& env, 
-        Heuristic* heuristic, unsigned long long frequency, const cxxtimer::Timer* timer,
-        double time_limit) {
+        Heuristic* heuristic, SolutionPool* pool, const IloNumVarArray& variables,
+        unsigned long long frequency, const cxxtimer::Timer* timer, double time_limit,
+        IncumbentBroadcast* broadcast) {
     return (IloCplex::Callback(new (env) orcs::HeuristicCallback(env, heuristic, 
-            frequency, timer, time_limit)));
+            pool, variables, frequency, timer, time_limit, broadcast)));
 }
 
 orcs::HeuristicCallback::HeuristicCallback(IloEnv& env, Heuristic* heuristic, 
-        unsigned long long frequency, const cxxtimer::Timer* timer,
-        double time_limit) :
-    IloCplex::HeuristicCallbackI(env), heuristic_(heuristic), 
-    frequency_(frequency), timer_(timer), time_limit_(time_limit)
+        SolutionPool* pool, const IloNumVarArray& variables, unsigned long long frequency,
+        const cxxtimer::Timer* timer, double time_limit, IncumbentBroadcast* broadcast) :
+    IloCplex::HeuristicCallbackI(env), heuristic_(heuristic), pool_(pool),
+    variables_(variables), timer_(timer), time_limit_(time_limit), frequency_(frequency),
+    broadcast_(broadcast)
 {
     // It does nothing here.
 }
@@ -22,9 +24,62 @@ IloCplex::CallbackI* orcs::HeuristicCallback::duplicateCallback() const {
 }
 
 void orcs::HeuristicCallback::main() {
-    if (frequency_ > 0ULL && heuristic_ != nullptr) {
+    if (frequency_ > 0ULL && heuristic_ != nullptr && hasIncumbent()) {
         if (getNnodes64() % frequency_ == 0) {
-            heuristic_->run(this, timer_, time_limit_);
+
+            std::size_t n = variables_.getSize();
+            IloNumArray values(getEnv(), n);
+            HeuristicContext context;
+
+            // Incumbent solution
+            getIncumbentValues(values, variables_);
+            incumbent_.resize(n);
+            for (std::size_t j = 0; j < n; ++j) {
+                incumbent_[j] = values[j];
+            }
+            context.incumbent = ValueSpan(incumbent_);
+            context.incumbent_objective = getIncumbentObjValue();
+
+            // LP relaxation of the current node
+            getValues(values, variables_);
+            relaxation_.resize(n);
+            for (std::size_t j = 0; j < n; ++j) {
+                relaxation_[j] = values[j];
+            }
+            context.relaxation = ValueSpan(relaxation_);
+            context.relaxation_objective = getObjValue();
+
+            // Pseudo-costs of the integer variables
+            down_pseudo_costs_.assign(n, 0.0);
+            up_pseudo_costs_.assign(n, 0.0);
+            for (std::size_t j = 0; j < n; ++j) {
+                if (variables_[j].getType() != IloNumVar::Type::Float) {
+                    down_pseudo_costs_[j] = getDownPseudoCost(variables_[j]);
+                    up_pseudo_costs_[j] = getUpPseudoCost(variables_[j]);
+                }
+            }
+            context.down_pseudo_costs = ValueSpan(down_pseudo_costs_);
+            context.up_pseudo_costs = ValueSpan(up_pseudo_costs_);
+
+            context.pool = pool_;
+            context.timer = timer_;
+            context.time_limit = time_limit_;
+            context.broadcast = broadcast_;
+            if (broadcast_ != nullptr) {
+                broadcast_->publish(context.incumbent_objective);
+            }
+
+            // Let CPLEX know about the solution found by the heuristic (CPLEX
+            // evaluates the solution by itself)
+            context.submit = [this, &values](ValueSpan solution, double) {
+                for (std::size_t j = 0; j < solution.size; ++j) {
+                    values[j] = solution[j];
+                }
+                setSolution(variables_, values);
+            };
+
+            heuristic_->run(context);
+            values.end();
         }
     }
 }
@@ -3,8 +3,11 @@
 
 
 #include <limits>
+#include <vector>
 #include <ilcplex/ilocplex.h>
 #include "heuristic.h"
+#include "solution_pool.h"
+#include "incumbent_broadcast.h"
 #include <cxxtimer.hpp>
 
 
@@ -16,7 +19,8 @@ namespace orcs {
     
 /**
  * Callback class used to perform custom heuristic methods throughout 
- * the CPLEX' branch-and-cut.
+ * the CPLEX' branch-and-cut. It fills the context of the heuristic with the
+ * data of the current node and sends the solutions found to CPLEX.
  */
 class HeuristicCallback : public IloCplex::HeuristicCallbackI {
 
@@ -30,6 +34,10 @@ public:
      *          CPLEX environment.
      * @param   heuristic
      *          A pointer to the heuristic object.
+     * @param   pool
+     *          A pointer to the pool of solutions shared with the heuristic.
+     * @param   variables
+     *          The variables of the problem.
      * @param   frequency
      *          Frequency the heuristic search is performed. If it is set to 100,
      *          the heuristic search is performed at nodes 100, 200, 300 and so 
@@ -39,10 +47,16 @@ public:
      *          optimization process.
      * @param   time_limit
      *          The time limit (in seconds) of the optimization process.
+     * @param   broadcast
+     *          The global incumbent, into which the incumbent of the
+     *          optimization process is published and which is given to the
+     *          heuristic (or nullptr, to disable it).
      */
     static IloCplex::Callback create_instance(IloEnv& env, Heuristic* heuristic, 
-            unsigned long long frequency, const cxxtimer::Timer* timer = nullptr,
-            double time_limit = std::numeric_limits<double>::max());
+            SolutionPool* pool, const IloNumVarArray& variables, unsigned long long frequency,
+            const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max(),
+            IncumbentBroadcast* broadcast = nullptr);
     
 protected:
     
@@ -54,14 +68,19 @@ protected:
      *          CPLEX environment.
      * @param   heuristic
      *          A pointer to the heuristic object.
+     * @param   pool
+     *          A pointer to the pool of solutions shared with the heuristic.
+     * @param   variables
+     *          The variables of the problem.
      * @param   frequency
      *          Frequency the heuristic search is performed. If it is set to 100,
      *          the heuristic search is performed at nodes 100, 200, 300 and so 
      *          on. If set to 0, the heuristic search will not be performed.
      */
-    HeuristicCallback(IloEnv& env, Heuristic* heuristic, 
-            unsigned long long frequency, const cxxtimer::Timer* timer,
-            double time_limit);
+    HeuristicCallback(IloEnv& env, Heuristic* heuristic, SolutionPool* pool,
+            const IloNumVarArray& variables, unsigned long long frequency,
+            const cxxtimer::Timer* timer,
+            double time_limit, IncumbentBroadcast* broadcast);
     
     IloCplex::CallbackI* duplicateCallback() const override;
     void main() override;
@@ -69,9 +88,20 @@ protected:
 private:
     
     Heuristic* heuristic_;
+    SolutionPool* pool_;
+    IloNumVarArray variables_;
     const cxxtimer::Timer* timer_;
     double time_limit_;
     unsigned long long frequency_;
+    IncumbentBroadcast* broadcast_;
+
+    /*
+     * Buffers with the data of the current node given to the heuristic.
+     */
+    std::vector<double> incumbent_;
+    std::vector<double> relaxation_;
+    std::vector<double> down_pseudo_costs_;
+    std::vector<double> up_pseudo_costs_;
 };
 
 }
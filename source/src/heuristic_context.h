@@ -0,0 +1,131 @@
+#ifndef ORCS_HEURISTIC_CONTEXT_H
+#define ORCS_HEURISTIC_CONTEXT_H
+
+
+#include "solution_pool.h"
+#include "incumbent_broadcast.h"
+#include <cstdlib>
+#include <vector>
+#include <limits>
+#include <functional>
+#include <cxxtimer.hpp>
+
+
+namespace orcs {
+
+/**
+ * A read-only view of a contiguous sequence of values indexed by the
+ * variables of the problem (a stand-in for C++20's std::span). An empty view
+ * means that the data is not available.
+ */
+struct ValueSpan {
+
+    const double* data;
+    std::size_t size;
+
+    /**
+     * Constructor of an empty view.
+     */
+    ValueSpan() : data(nullptr), size(0) {}
+
+    /**
+     * Constructor.
+     *
+     * @param   data
+     *          A pointer to the first value.
+     * @param   size
+     *          The number of values.
+     */
+    ValueSpan(const double* data, std::size_t size) : data(data), size(size) {}
+
+    /**
+     * Constructor of a view over the values of a vector.
+     *
+     * @param   values
+     *          The vector of values.
+     */
+    ValueSpan(const std::vector<double>& values) : data(values.data()), size(values.size()) {}
+
+    /**
+     * Return whether the view is empty.
+     *
+     * @return  True if the view has no values, false otherwise.
+     */
+    bool empty() const { return size == 0; }
+
+    /**
+     * Return a value.
+     *
+     * @param   idx
+     *          Index of the value.
+     *
+     * @return  The value.
+     */
+    double operator[](std::size_t idx) const { return data[idx]; }
+};
+
+/**
+ * Data made available to a heuristic at each time it is called, independent
+ * of the solver (or the engine) that calls it. Optional data are given as
+ * empty views. Solutions found by the heuristic are handed to the caller
+ * through the solution sink.
+ */
+struct HeuristicContext {
+
+    /*
+     * The incumbent solution and its objective value.
+     */
+    ValueSpan incumbent;
+    double incumbent_objective = 0.0;
+
+    /*
+     * The solution of the relaxation (e.g., the LP relaxation of the current
+     * node of a branch-and-bound) and its objective value.
+     */
+    ValueSpan relaxation;
+    double relaxation_objective = 0.0;
+
+    /*
+     * The pseudo-costs of branching down and up on each variable.
+     */
+    ValueSpan down_pseudo_costs;
+    ValueSpan up_pseudo_costs;
+
+    /*
+     * The pool of solutions shared with the caller.
+     */
+    SolutionPool* pool = nullptr;
+
+    /*
+     * The timer of the entire optimization process and its time limit (in
+     * seconds), which are the deadline of the heuristic.
+     */
+    const cxxtimer::Timer* timer = nullptr;
+    double time_limit = std::numeric_limits<double>::max();
+
+    /*
+     * The global incumbent polled by the sub-MIPs of the heuristic (or
+     * nullptr, if sub-MIPs are not preempted by solutions found elsewhere).
+     */
+    IncumbentBroadcast* broadcast = nullptr;
+
+    /*
+     * Solution sink. It receives the best solution found by the heuristic
+     * and its objective value.
+     */
+    std::function<void(ValueSpan, double)> submit;
+
+    /**
+     * Return whether the deadline of the heuristic has passed.
+     *
+     * @return  True if the time limit has been reached, false otherwise.
+     */
+    bool expired() const {
+        return timer != nullptr && (timer->count<std::chrono::milliseconds>() / 1000.0) >= time_limit;
+    }
+};
+
+}
+
+
+#endif
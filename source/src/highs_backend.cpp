@@ -0,0 +1,195 @@
+#include "highs_backend.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+
+orcs::HighsBackend::HighsBackend(const BackendModel& model, const BackendLimits& limits) :
+        limits_(limits), last_improvement_(0), status_(SubmipStatus::UNKNOWN), objective_(0.0)
+{
+    std::size_t n = model.objective.size();
+    std::size_t m = model.row_lb.size();
+
+    // Build the model of HiGHS (it regards bounds of absolute value at least
+    // 1e20, as the infinity of CPLEX, as infinite)
+    HighsModel highs_model;
+    HighsLp& lp = highs_model.lp_;
+    lp.num_col_ = n;
+    lp.num_row_ = m;
+    lp.sense_ = (model.maximize ? ObjSense::kMaximize : ObjSense::kMinimize);
+    lp.offset_ = model.objective_constant;
+    lp.col_cost_ = model.objective;
+    lp.col_lower_ = model.column_lb;
+    lp.col_upper_ = model.column_ub;
+    lp.row_lower_ = model.row_lb;
+    lp.row_upper_ = model.row_ub;
+    lp.integrality_.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        lp.integrality_[j] = (model.integer[j] ? HighsVarType::kInteger : HighsVarType::kContinuous);
+    }
+
+    lp.a_matrix_.format_ = MatrixFormat::kColwise;
+    lp.a_matrix_.num_col_ = n;
+    lp.a_matrix_.num_row_ = m;
+    lp.a_matrix_.start_.assign(model.column_start.begin(), model.column_start.end());
+    lp.a_matrix_.index_.assign(model.column_rows.begin(), model.column_rows.end());
+    lp.a_matrix_.value_ = model.column_coefs;
+
+    lb_ = model.column_lb;
+    ub_ = model.column_ub;
+    solution_.resize(n);
+
+    // Set HiGHS instance used to solve sub-MIPs
+    highs_.setOptionValue("output_flag", false);
+    highs_.setOptionValue("threads", 1);
+    highs_.setOptionValue("random_seed", limits_.seed);
+    highs_.setOptionValue("mip_max_nodes", static_cast<HighsInt>(
+            std::min<long>(limits_.nodes_limit, std::numeric_limits<HighsInt>::max())));
+
+    // Abort by the criteria of the abort callback of CPLEX: too many MIP
+    // nodes explored without improvement of the incumbent solution (the
+    // option mip_max_stall_nodes of HiGHS counts the nodes without progress
+    // of the gap, which is a different criterion) and stall of the gap over a
+    // sliding window
+    bool stall = (limits_.stall_window_nodes < std::numeric_limits<unsigned long long>::max() ||
+            limits_.stall_window_time < std::numeric_limits<double>::max());
+    if (limits_.nodes_unsuccessful < std::numeric_limits<long>::max() || stall) {
+        highs_.setCallback([](int callback_type, const std::string& /* message */,
+                const HighsCallbackDataOut* data_out, HighsCallbackDataIn* data_in,
+                void* user_callback_data) {
+            HighsBackend* backend = static_cast<HighsBackend*>(user_callback_data);
+            long long nodes = data_out->mip_node_count;
+            if (callback_type == kCallbackMipImprovingSolution) {
+                backend->last_improvement_ = nodes;
+            } else if (callback_type == kCallbackMipInterrupt) {
+                bool has_incumbent = std::abs(data_out->mip_primal_bound) < kHighsInf;
+                if (backend->abort(nodes, data_out->running_time, has_incumbent, data_out->mip_gap)) {
+                    data_in->user_interrupt = true;
+                }
+            }
+        }, this);
+        highs_.startCallback(kCallbackMipImprovingSolution);
+        highs_.startCallback(kCallbackMipInterrupt);
+    }
+
+    if (highs_.passModel(std::move(highs_model)) == HighsStatus::kError) {
+        throw std::string("Unable to load the problem into HiGHS.");
+    }
+}
+
+orcs::HighsBackend::~HighsBackend() {
+    // Nothing to do
+}
+
+void orcs::HighsBackend::set_bounds(std::size_t idx, double lb, double ub) {
+    if (lb_[idx] != lb || ub_[idx] != ub) {
+        highs_.changeColBounds(idx, lb, ub);
+        lb_[idx] = lb;
+        ub_[idx] = ub;
+    }
+}
+
+void orcs::HighsBackend::set_start(const std::vector<double>& start) {
+    start_ = start;
+}
+
+bool orcs::HighsBackend::solve(const cxxtimer::Timer* timer, double time_limit) {
+
+    // Check timer (stop criterion)
+    double remaining = time_limit;
+    if (timer != nullptr) {
+        remaining -= timer->count<std::chrono::milliseconds>() / 1000.0;
+    }
+
+    if (remaining <= 0.0) {
+        status_ = SubmipStatus::UNKNOWN;
+        return false;
+    }
+
+    highs_.setOptionValue("time_limit", remaining);
+
+    // Set a MIP start solution
+    if (!start_.empty()) {
+        HighsSolution start_solution;
+        start_solution.value_valid = true;
+        start_solution.col_value = start_;
+        highs_.setSolution(start_solution);
+        start_.clear();
+    }
+
+    // Optimize the sub-MIP
+    last_improvement_ = 0;
+    window_.clear();
+    highs_.run();
+    const HighsInfo& info = highs_.getInfo();
+    bool found = (info.primal_solution_status == kSolutionStatusFeasible);
+
+    switch (highs_.getModelStatus()) {
+        case HighsModelStatus::kOptimal:
+            status_ = SubmipStatus::OPTIMAL;
+            break;
+        case HighsModelStatus::kInfeasible:
+            status_ = SubmipStatus::INFEASIBLE;
+            break;
+        default:
+            status_ = (found ? SubmipStatus::FEASIBLE : SubmipStatus::UNKNOWN);
+            break;
+    }
+
+    if (found) {
+        objective_ = info.objective_function_value;
+        const std::vector<double>& values = highs_.getSolution().col_value;
+        for (std::size_t j = 0; j < solution_.size(); ++j) {
+            solution_[j] = values[j];
+        }
+    }
+
+    return found;
+}
+
+orcs::SubmipStatus orcs::HighsBackend::status() const {
+    return status_;
+}
+
+double orcs::HighsBackend::objective() const {
+    return objective_;
+}
+
+const std::vector<double>& orcs::HighsBackend::solution() const {
+    return solution_;
+}
+
+bool orcs::HighsBackend::abort(long long nodes, double time, bool has_incumbent, double gap) {
+
+    // Abort, if maximum number of MIP nodes without improvement has been reached
+    if (nodes - last_improvement_ > limits_.nodes_unsuccessful) {
+        return true;
+    }
+
+    // Abort, if the progress over the sliding window is too small
+    bool stall = (limits_.stall_window_nodes < std::numeric_limits<unsigned long long>::max() ||
+            limits_.stall_window_time < std::numeric_limits<double>::max());
+    if (stall && has_incumbent) {
+
+        Sample current {nodes, time, std::min(1.0, gap)};
+        if (window_.empty() || current.nodes > window_.back().nodes) {
+            window_.push_back(current);
+        }
+
+        // Keep the newest sample that spans the entire window as the first one
+        auto spans = [this, &current](const Sample& sample) {
+            return (unsigned long long) (current.nodes - sample.nodes) >= limits_.stall_window_nodes ||
+                    current.time - sample.time >= limits_.stall_window_time;
+        };
+
+        while (window_.size() >= 2 && spans(window_[1])) {
+            window_.pop_front();
+        }
+
+        if (spans(window_.front()) && window_.front().gap - current.gap < limits_.stall_min_progress) {
+            return true;
+        }
+    }
+
+    return false;
+}
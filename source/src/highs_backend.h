@@ -0,0 +1,97 @@
+#ifndef ORCS_HIGHS_BACKEND_H
+#define ORCS_HIGHS_BACKEND_H
+
+#include "submip_backend.h"
+#include <cstdlib>
+#include <vector>
+#include <deque>
+#include <Highs.h>
+#include <cxxtimer.hpp>
+
+
+namespace orcs {
+
+/**
+ * Sub-MIP backend based on the open-source solver HiGHS. The problem is passed
+ * to HiGHS from plain arrays, then neither a CPLEX environment nor the CPLEX
+ * headers are required. It is only available if the program is built with
+ * HiGHS support (ORCS_WITH_HIGHS).
+ */
+class HighsBackend : public SubmipBackend {
+
+public:
+
+    /**
+     * Constructor. It builds its own copy of the problem.
+     *
+     * @param   model
+     *          The constraint matrix, bounds and types of the variables of the
+     *          problem.
+     * @param   limits
+     *          The stopping criteria of the sub-MIPs.
+     */
+    HighsBackend(const BackendModel& model, const BackendLimits& limits);
+
+    /**
+     * Destructor.
+     */
+    virtual ~HighsBackend();
+
+    void set_bounds(std::size_t idx, double lb, double ub) override;
+    void set_start(const std::vector<double>& start) override;
+    bool solve(const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max()) override;
+    SubmipStatus status() const override;
+    double objective() const override;
+    const std::vector<double>& solution() const override;
+
+    HighsBackend(const HighsBackend& other) = delete;
+    HighsBackend(HighsBackend&& other) = delete;
+    HighsBackend& operator=(const HighsBackend& other) = delete;
+    HighsBackend& operator=(HighsBackend&& other) = delete;
+
+private:
+
+    Highs highs_;
+
+    /*
+     * Current bounds of the variables (used to avoid redundant updates) and
+     * the MIP start of the next solve.
+     */
+    std::vector<double> lb_;
+    std::vector<double> ub_;
+    std::vector<double> start_;
+
+    /**
+     * Check the stopping criteria of the sub-MIP (called by the callback of
+     * HiGHS, as the abort callback of CPLEX does). It returns true if the
+     * sub-MIP must be aborted.
+     */
+    bool abort(long long nodes, double time, bool has_incumbent, double gap);
+
+    /*
+     * Stopping criteria, the node of the last improvement of the incumbent
+     * solution and the samples of the sliding window of the stall criterion
+     * (node, time and relative gap).
+     */
+    struct Sample {
+        long long nodes;
+        double time;
+        double gap;
+    };
+
+    BackendLimits limits_;
+    long long last_improvement_;
+    std::deque<Sample> window_;
+
+    /*
+     * Result of the last solve.
+     */
+    SubmipStatus status_;
+    double objective_;
+    std::vector<double> solution_;
+};
+
+}
+
+#endif
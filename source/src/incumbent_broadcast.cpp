@@ -0,0 +1,33 @@
+#include "incumbent_broadcast.h"
+#include <limits>
+
+
+orcs::IncumbentBroadcast::IncumbentBroadcast(IloObjective::Sense sense) :
+        sense_(sense),
+        value_(sense == IloObjective::Minimize ? std::numeric_limits<double>::infinity() :
+                -std::numeric_limits<double>::infinity())
+{
+    // It does nothing here.
+}
+
+bool orcs::IncumbentBroadcast::publish(double value) {
+    double current = value_.load(std::memory_order_relaxed);
+    while (sense_ == IloObjective::Minimize ? value < current : value > current) {
+        if (value_.compare_exchange_weak(current, value, std::memory_order_release,
+                std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+double orcs::IncumbentBroadcast::value() const {
+    return value_.load(std::memory_order_acquire);
+}
+
+bool orcs::IncumbentBroadcast::dominates(double value) const {
+    double incumbent = value_.load(std::memory_order_acquire);
+    return (sense_ == IloObjective::Minimize ?
+            value >= incumbent - THRESHOLD : value <= incumbent + THRESHOLD);
+}
@@ -0,0 +1,90 @@
+#ifndef ORCS_INCUMBENT_BROADCAST_H
+#define ORCS_INCUMBENT_BROADCAST_H
+
+#include <atomic>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * The value of the objective function of the global incumbent solution,
+ * published by every search that finds solutions of the problem (the main
+ * branch-and-cut, sub-MIPs and nested heuristics) and polled by the sub-MIPs
+ * in flight. A sub-MIP whose best bound cannot beat the global incumbent
+ * anymore (e.g., its neighborhood was built around a solution that became
+ * stale after a large improvement found elsewhere) is preempted, since no
+ * solution beneath the current best is useful to improve it.
+ *
+ * Note that no search publishes while a sub-MIP is in flight yet: the main
+ * branch-and-cut is blocked in the heuristic callback, split components
+ * do not use it and the solutions of a nested heuristic are also given to
+ * its parent sub-MIP. Then the preemption has no effect so far; it is meant
+ * for searches running concurrently with sub-MIPs.
+ *
+ * The value is kept in an atomic variable: it is published and read without
+ * locks and it only improves (a value worse than the current one is ignored).
+ */
+class IncumbentBroadcast {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   sense
+     *          The optimization sense of the problem.
+     */
+    explicit IncumbentBroadcast(IloObjective::Sense sense);
+
+    /**
+     * Publish the value of a solution. It replaces the global incumbent only
+     * if it is better.
+     *
+     * @param   value
+     *          The value of the objective function of the solution.
+     *
+     * @return  True if the global incumbent was improved, false otherwise.
+     */
+    bool publish(double value);
+
+    /**
+     * Return the value of the global incumbent (infinity, if none has been
+     * published yet).
+     *
+     * @return  The value of the objective function of the global incumbent.
+     */
+    double value() const;
+
+    /**
+     * Return whether a value is worse than the global incumbent, i.e., if a
+     * bound of a search is dominated by the global incumbent.
+     *
+     * @param   value
+     *          A value of the objective function (or a bound of it).
+     *
+     * @return  True if the value cannot improve the global incumbent.
+     */
+    bool dominates(double value) const;
+
+    IncumbentBroadcast(const IncumbentBroadcast& other) = delete;
+    IncumbentBroadcast(IncumbentBroadcast&& other) = delete;
+    IncumbentBroadcast& operator=(const IncumbentBroadcast& other) = delete;
+    IncumbentBroadcast& operator=(IncumbentBroadcast&& other) = delete;
+
+private:
+
+    /*
+     * The optimization sense and the global incumbent.
+     */
+    IloObjective::Sense sense_;
+    std::atomic<double> value_;
+
+    static constexpr double THRESHOLD = 1e-5;
+};
+
+}
+
+#endif
@@ -7,15 +7,31 @@
 #include <limits>
 #include <chrono>
 #include <set>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <sys/resource.h>
 #include <ilcplex/ilocplex.h>
 #include <cxxopts.hpp>
 #include <cxxtimer.hpp>
-#include <cxxproperties.hpp>
 #include "problem_data.h"
 #include "solution_pool.h"
+#include "symmetry.h"
+#include "placement.h"
+#include "submip_backend.h"
+#include "parameters.h"
+#include "fix_and_propagate.h"
+#include "config_file.h"
+#include "pool_file.h"
 #include "pool_callback.h"
+#include "pool_branch_callback.h"
 #include "heuristic_callback.h"
 #include "abort_callback.h"
+#include "incumbent_broadcast.h"
+#include "checkpoint.h"
+#include "checkpoint_callback.h"
 #include "rothberg.h"
 #include "maravilha.h"
 
@@ -51,6 +67,10 @@ struct Result {
 cxxopts::Options
 create_command_parser(int argc, char** argv);
 
+std::string
+find_argument(int argc, char** argv,
+              const std::string& name);
+
 void
 print_command_help(const cxxopts::Options&options,
                    std::ostream& output);
@@ -66,6 +86,13 @@ print_results(orcs::ProblemData& problem,
               const Result& after,
               const cxxopts::Options& options);
 
+void
+write_statistics(const std::string& filename,
+                 const orcs::Heuristic* heuristic,
+                 const Result& before,
+                 const Result& after,
+                 const cxxopts::Options& options);
+
 void
 print_details_1(orcs::ProblemData& problem,
                 const Result& before,
@@ -122,6 +149,133 @@ int main(int argc, char** argv) {
             throw std::string("Invalid heuristic method.");
         }
 
+        // Abort, if fixing strategy is not valid
+        std::set<std::string> fixing_strategy_values = {"random", "reduced-cost", "pseudo-cost", "combined"};
+        if (fixing_strategy_values.count(options["fixing-strategy"].as<std::string>()) == 0) {
+            throw std::string("Invalid fixing strategy.");
+        }
+
+        // Abort, if neighborhood sampling is not valid
+        std::set<std::string> sampling_values = {"independent", "connected"};
+        if (sampling_values.count(options["sampling"].as<std::string>()) == 0) {
+            throw std::string("Invalid neighborhood sampling.");
+        }
+
+        // Abort, if Rothberg's neighborhood is not valid
+        std::set<std::string> neighborhood_values = {"fixing", "local-branching"};
+        if (neighborhood_values.count(options["rothberg-neighborhood"].as<std::string>()) == 0) {
+            throw std::string("Invalid neighborhood for Rothberg's heuristic.");
+        }
+
+        // Abort, if constructive order is not valid
+        std::set<std::string> constructive_order_values = {"random", "relaxation"};
+        if (constructive_order_values.count(options["constructive-order"].as<std::string>()) == 0) {
+            throw std::string("Invalid order of the constructive heuristic.");
+        }
+
+        // Abort, if checkpoint options are not valid
+        if (options.count("checkpoint") > 0 && options["checkpoint-interval"].as<double>() < 0.0) {
+            throw std::string("Invalid checkpoint interval.");
+        }
+
+        if (options.count("resume") > 0 && options.count("checkpoint") == 0) {
+            throw std::string("Invalid resume (no checkpoint file has been specified).");
+        }
+
+        // Abort, if placement policy is not valid
+        std::set<std::string> placement_values = {"none", "compact", "scatter"};
+        if (placement_values.count(options["placement"].as<std::string>()) == 0) {
+            throw std::string("Invalid placement policy.");
+        }
+
+        // Parameters of the MIP heuristics (typed and validated once, then
+        // shared by the heuristics and their sub-MIP solvers)
+        orcs::HeuristicParameters heuristic_params;
+        heuristic_params.fixing_strategy = orcs::FixingScores::parse_strategy(options["fixing-strategy"].as<std::string>());
+        heuristic_params.connected_sampling = (options["sampling"].as<std::string>().compare("connected") == 0);
+
+        orcs::SubmipParameters& submip_params = heuristic_params.submip;
+        submip_params.seed = options["seed"].as<unsigned long>();
+        submip_params.nodes_limit = options["submip-nodes-limit"].as<long>();
+        if (options.count("submip-nodes-unsuccessful") > 0) {
+            submip_params.nodes_unsuccessful = options["submip-nodes-unsuccessful"].as<long>();
+        }
+        if (options.count("submip-stall-window") > 0) {
+            submip_params.stall = orcs::StallCriterion(options["submip-stall-window"].as<long>(),
+                    std::numeric_limits<double>::max(), options["submip-stall-progress"].as<double>());
+        }
+        if (options.count("submip-early-exit") > 0) {
+            submip_params.early_exit = options["submip-early-exit"].as<double>();
+        }
+        submip_params.pool_starts = options["submip-pool-starts"].as<bool>();
+        submip_params.widening_steps = options["submip-widening-steps"].as<long>();
+        submip_params.widening_batch = options["submip-widening-batch"].as<double>();
+        submip_params.split_components = options["submip-split-components"].as<bool>();
+        submip_params.component_min_size = options["submip-component-min-size"].as<long>();
+        submip_params.workers = options["submip-workers"].as<long>();
+        submip_params.backend = options["submip-backend"].as<std::string>();
+        submip_params.backend_threshold = options["submip-backend-threshold"].as<long>();
+        submip_params.placement = orcs::Placement::parse_policy(options["placement"].as<std::string>());
+        submip_params.lp_polishing = options["submip-lp-polishing"].as<bool>();
+        submip_params.recursion_depth = options["submip-recursion-depth"].as<long>();
+        submip_params.recursion_min_size = options["submip-recursion-min-size"].as<long>();
+        submip_params.recursion_frequency = options["submip-recursion-frequency"].as<long>();
+        heuristic_params.predictor.threshold = options["predictor-threshold"].as<double>();
+        heuristic_params.predictor.resamples = options["predictor-resamples"].as<long>();
+        heuristic_params.predictor.learning_rate = options["predictor-learning-rate"].as<double>();
+        heuristic_params.predictor.warmup = options["predictor-warmup"].as<long>();
+        heuristic_params.predictor.exploration = options["predictor-exploration"].as<double>();
+        heuristic_params.validate();
+
+        // Abort, if sub-MIP backend is not available in this build (or it
+        // would be ignored, since only the workers that solve independent
+        // components use it)
+        if (submip_params.backend != "cplex" && !orcs::SubmipBackend::available("highs")) {
+            throw std::string("Invalid sub-MIP backend (built without HiGHS support).");
+        }
+        if (submip_params.backend != "cplex" && (!submip_params.split_components || submip_params.workers == 0)) {
+            throw std::string("Invalid sub-MIP backend (it requires --submip-split-components and "
+                    "--submip-workers greater than zero).");
+        }
+
+        orcs::ConstructiveParameters constructive_params;
+        constructive_params.attempts = options["constructive-attempts"].as<long>();
+        constructive_params.threads = options["constructive-threads"].as<long>();
+        constructive_params.order = (options["constructive-order"].as<std::string>().compare("relaxation") == 0 ?
+                orcs::ConstructiveParameters::Order::RELAXATION : orcs::ConstructiveParameters::Order::RANDOM);
+        constructive_params.candidates = options["constructive-candidates"].as<long>();
+        constructive_params.repair_nodes = options["constructive-repair-nodes"].as<long>();
+        constructive_params.time_limit = options["constructive-time-limit"].as<double>();
+        constructive_params.seed = submip_params.seed;
+        constructive_params.placement = submip_params.placement;
+        constructive_params.validate();
+
+        orcs::MaravilhaParameters maravilha_params;
+        maravilha_params.iterations = options["maravilha-iterations"].as<long>();
+        maravilha_params.submip_min = options["maravilha-submip-min"].as<double>();
+        maravilha_params.submip_max = options["maravilha-submip-max"].as<double>();
+        maravilha_params.offset = options["maravilha-offset"].as<double>();
+        maravilha_params.relaxation_cache = options["maravilha-relaxation-cache"].as<long>();
+        maravilha_params.relaxation_diversity = options["maravilha-relaxation-diversity"].as<double>();
+        maravilha_params.validate();
+
+        orcs::RothbergParameters rothberg_params;
+        rothberg_params.recombinations = options["rothberg-recombinations"].as<long>();
+        rothberg_params.mutations = options["rothberg-mutations"].as<long>();
+        rothberg_params.fixing_fraction = options["rothberg-fixing-fraction"].as<double>();
+        rothberg_params.offset_init = options["rothberg-offset-init"].as<double>();
+        rothberg_params.offset_reduction = options["rothberg-offset-reduction"].as<double>();
+        rothberg_params.offset_minimum = options["rothberg-offset-minimum"].as<double>();
+        rothberg_params.local_branching = (options["rothberg-neighborhood"].as<std::string>().compare("local-branching") == 0);
+        rothberg_params.batch = options["rothberg-batch"].as<long>();
+        rothberg_params.validate();
+
+        // Pin the main search to its core (before loading the problem, so that
+        // its data is local to the NUMA node of the core)
+        orcs::Placement placement(orcs::Placement::parse_policy(options["placement"].as<std::string>()));
+        placement.pin_main();
+        orcs::Placement::set_huge_pages(options.count("huge-pages") > 0);
+
         // Disable CPLEX output log
         env.setOut(env.getNullStream());
         env.setWarning(env.getNullStream());
@@ -140,29 +294,186 @@ int main(int argc, char** argv) {
             problem.cplex.setParam(IloCplex::Param::MIP::Display, 2);
         }
 
+        // Global incumbent shared by the branch-and-cut and the sub-MIPs
+        orcs::IncumbentBroadcast incumbent_broadcast(problem.objective.getSense());
+        orcs::IncumbentBroadcast* broadcast = (options.count("submip-live-cutoff") > 0 ? &incumbent_broadcast : nullptr);
+
         // Add solution pool callback
         orcs::SolutionPool pool(problem.env, problem.objective.getSense(), options["pool-size"].as<long>(), true);
-        problem.cplex.use(orcs::PoolCallback::create_instance(env, &pool, problem.variables));
+        problem.cplex.use(orcs::PoolCallback::create_instance(env, &pool, problem.variables, broadcast));
+
+        // Reject solutions symmetric to the ones in the pool
+        orcs::Symmetry* symmetry = nullptr;
+        if (options.count("pool-symmetry") > 0) {
+            symmetry = new orcs::Symmetry(problem);
+            if (symmetry->detected()) {
+                pool.set_symmetry(symmetry);
+            }
+        }
+
+        // Restore the checkpoint of an interrupted run, if any: its solutions
+        // seed the pool and the MIP starts, and the time and MIP nodes it
+        // spent are discounted from the budgets (which are given for the
+        // entire optimization process, while the timer and CPLEX count this
+        // run only)
+        orcs::Checkpoint resumed;
+        bool resuming = false;
+        if (options.count("resume") > 0) {
+            std::ifstream checkpoint_file(options["checkpoint"].as<std::string>());
+            resuming = checkpoint_file.good();
+            checkpoint_file.close();
+
+            if (resuming) {
+                resumed.read(options["checkpoint"].as<std::string>(), problem.variables.getSize());
+
+                IloNumArray values(problem.env, problem.variables.getSize());
+                for (std::size_t s = 0; s < resumed.solutions.size(); ++s) {
+                    for (std::size_t j = 0; j < (std::size_t) values.getSize(); ++j) {
+                        values[j] = resumed.solutions[s][j];
+                    }
+                    pool.add_entry(values, resumed.objectives[s]);
+                    problem.cplex.addMIPStart(problem.variables, values, IloCplex::MIPStartCheckFeas);
+                }
+                values.end();
+            }
+        }
+
+        double time_offset = resumed.elapsed;
+        long long nodes_offset = resumed.nodes;
 
         // Triggers to start heuristic
         if (options.count("heuristic-trigger-nodes") > 0) {
-            problem.cplex.setParam(IloCplex::Param::MIP::Limits::Nodes, options["heuristic-trigger-nodes"].as<long>());
+            problem.cplex.setParam(IloCplex::Param::MIP::Limits::Nodes,
+                    std::max<long long>(0, options["heuristic-trigger-nodes"].as<long>() - nodes_offset));
         }
 
         if (options.count("heuristic-trigger-time") > 0) {
-            problem.cplex.setParam(IloCplex::Param::TimeLimit, options["heuristic-trigger-time"].as<double>());
+            problem.cplex.setParam(IloCplex::Param::TimeLimit,
+                    std::max(0.0, options["heuristic-trigger-time"].as<double>() - time_offset));
         }
 
         // Timer (used to compute running time)
         cxxtimer::Timer timer;
 
-        // Solve model (1st phase: before heuristics)
+        // Periodic checkpoints
+        orcs::Checkpointer* checkpointer = nullptr;
+        if (options.count("checkpoint") > 0) {
+            checkpointer = new orcs::Checkpointer(options["checkpoint"].as<std::string>(),
+                    options["checkpoint-interval"].as<double>(), &pool, &timer, time_offset, nodes_offset);
+            problem.cplex.use(orcs::CheckpointCallback::create_instance(env, checkpointer));
+        }
+
+        // Build the heuristic (its copy of the problem, sub-MIP solver and
+        // workers) in the background while the 1st phase runs, so that the
+        // 2nd phase starts without setup delay. The heuristic loads its copy
+        // of the problem into its own CPLEX environment, then it does not
+        // interfere with the 1st phase (the constructors only read the name
+        // of the file of the problem, which is not a Concert object, and keep
+        // the pointer for the calls made later from the CPLEX thread). The
+        // thread runs on the NUMA node of the main search, which uses the
+        // data it builds.
+        orcs::Heuristic* heuristic = nullptr;
+        std::exception_ptr heuristic_error;
+        std::thread heuristic_setup([&]() {
+            try {
+                placement.pin_main_node();
+                if (options["heuristic"].as<std::string>().compare("maravilha") == 0) {
+                    heuristic = new orcs::Maravilha(&problem, heuristic_params, maravilha_params);
+                } else if (options["heuristic"].as<std::string>().compare("rothberg") == 0) {
+                    heuristic = new orcs::Rothberg(&problem, heuristic_params, rothberg_params);
+                }
+            } catch (...) {
+                heuristic_error = std::current_exception();
+            }
+        });
+
+        // Solve model (1st phase: before heuristics). A run resumed from
+        // the 2nd phase skips it, and the constructive heuristic is not run
+        // again by resumed runs (their pool has its solutions already).
         timer.start();
-        problem.cplex.solve();
+        try {
+
+            // Seed the pool and the MIP starts with the solutions found by a
+            // run of the fix-and-propagate heuristic
+            auto seed_pool = [&](const orcs::FixAndPropagate& constructive) {
+                IloNumArray values(problem.env, problem.variables.getSize());
+                for (std::size_t s = 0; s < constructive.solutions().size(); ++s) {
+                    for (std::size_t j = 0; j < (std::size_t) values.getSize(); ++j) {
+                        values[j] = constructive.solutions()[s][j];
+                    }
+                    pool.add_entry(values, constructive.objectives()[s]);
+                    problem.cplex.addMIPStart(problem.variables, values, IloCplex::MIPStartCheckFeas);
+                }
+                values.end();
+            };
+
+            // Warm start from the pool of a previous run: its solutions are
+            // mapped onto this problem by the names of the variables and
+            // repaired (the variables unknown to the file are left free, and
+            // solutions with no variable of this problem are skipped)
+            if (options.count("warm-pool") > 0 && !resuming) {
+                orcs::PoolFile warm_pool(options["warm-pool"].as<std::string>());
+                std::vector<std::vector<double>> hints;
+                for (std::size_t s = 0; s < warm_pool.size(); ++s) {
+                    std::size_t num_mapped = 0;
+                    std::vector<double> hint = warm_pool.map(s, problem.variables, num_mapped);
+                    if (num_mapped > 0) {
+                        hints.push_back(std::move(hint));
+                    }
+                }
+
+                if (!hints.empty()) {
+                    orcs::FixAndPropagate repair(&problem, constructive_params);
+                    repair.run(hints, &timer);
+                    seed_pool(repair);
+                }
+            }
+
+            // Seed them with the solutions found by the constructive heuristic
+            // (before the branch-and-cut finds any)
+            if (constructive_params.attempts > 0 && !resuming) {
+                orcs::FixAndPropagate constructive(&problem, constructive_params);
+                constructive.run(&timer);
+                seed_pool(constructive);
+            }
+
+            if (resumed.phase == 1) {
+                problem.cplex.solve();
+            }
+        } catch (...) {
+            heuristic_setup.join();
+            delete heuristic;
+            throw;
+        }
         timer.stop();
 
+        // Wait for the heuristic to be ready
+        heuristic_setup.join();
+        if (heuristic_error) {
+            std::rethrow_exception(heuristic_error);
+        }
+
+        // Restore the state of the heuristic
+        if (resuming && resumed.phase == 2 && heuristic != nullptr) {
+            std::istringstream heuristic_state(resumed.heuristic_state);
+            heuristic->read_state(heuristic_state);
+        }
+
         // Get result
-        Result result_before_heuristic = get_result(problem, pool, timer);
+        Result result_before_heuristic;
+        if (resumed.phase == 1) {
+            result_before_heuristic = get_result(problem, pool, timer);
+            result_before_heuristic.runtime += time_offset;
+            result_before_heuristic.mip_nodes_explored += nodes_offset;
+        } else {
+            result_before_heuristic.status = (pool.size() > 0 ? IloAlgorithm::Status::Feasible : IloAlgorithm::Status::Unknown);
+            result_before_heuristic.mip_nodes_explored = resumed.before_nodes;
+            result_before_heuristic.runtime = resumed.before_runtime;
+            result_before_heuristic.objective_value = (pool.size() > 0 ? pool.get_entries().front().value :
+                    (problem.objective.getSense() == IloObjective::Minimize ?
+                    std::numeric_limits<double>::max() : -std::numeric_limits<double>::max()));
+            result_before_heuristic.pool_size = pool.size();
+        }
 
         // Reset CPLEX stopping criteria
         problem.cplex.setParam(IloCplex::Param::MIP::Limits::Nodes, CPLEX_DEFAULT_LIMIT_NODES);
@@ -177,17 +488,26 @@ int main(int argc, char** argv) {
             time_limit = std::min(time_limit, (1.0 + options["heuristic-proportional-time-limit"].as<double>()) * result_before_heuristic.runtime);
         }
 
+        unsigned long long nodes_limit = std::numeric_limits<unsigned long long>::max();
         if (options.count("heuristic-nodes-limit") > 0) {
-            long nodes_limit = result_before_heuristic.mip_nodes_explored + options["heuristic-nodes-limit"].as<long>();
-            problem.cplex.use(orcs::AbortCallback::create_instance(env, &timer, time_limit, nodes_limit));
-        } else {
-            problem.cplex.use(orcs::AbortCallback::create_instance(env, &timer, time_limit));
+            nodes_limit = std::max<long long>(0, result_before_heuristic.mip_nodes_explored + options["heuristic-nodes-limit"].as<long>() - nodes_offset);
         }
 
-        // Initialize heuristic method
-        orcs::Heuristic* heuristic = nullptr;
-        cxxproperties::Properties heuristic_params;
+        if (time_limit < std::numeric_limits<double>::max()) {
+            time_limit -= time_offset;
+        }
+
+        orcs::StallCriterion stall;
+        if (options.count("stall-window") > 0) {
+            stall = orcs::StallCriterion(std::numeric_limits<unsigned long long>::max(),
+                    options["stall-window"].as<double>(), options["stall-progress"].as<double>());
+        }
 
+        problem.cplex.use(orcs::AbortCallback::create_instance(env, &timer, time_limit, nodes_limit,
+                std::numeric_limits<unsigned long long>::max(), problem.objective.getSense(),
+                std::numeric_limits<double>::quiet_NaN(), stall));
+
+        // Initialize heuristic method
         if (options["heuristic"].as<std::string>().compare("none") != 0) {
 
             if (options["heuristic"].as<std::string>().compare("cplex-polishing") == 0) {
@@ -213,6 +533,14 @@ int main(int argc, char** argv) {
                     polishing_nodes_limit = result_before_heuristic.mip_nodes_explored + options["heuristic-nodes-limit"].as<long>();
                 }
 
+                if (polishing_time_limit < CPLEX_DEFAULT_LIMIT_TIME) {
+                    polishing_time_limit = std::max(0.0, polishing_time_limit - time_offset);
+                }
+
+                if (polishing_nodes_limit < (long) CPLEX_DEFAULT_LIMIT_NODES) {
+                    polishing_nodes_limit = std::max(0L, polishing_nodes_limit - (long) nodes_offset);
+                }
+
                 problem.cplex.setParam(IloCplex::Param::MIP::Limits::Nodes, polishing_nodes_limit);
                 problem.cplex.setParam(IloCplex::Param::TimeLimit, polishing_time_limit);
 
@@ -222,48 +550,25 @@ int main(int argc, char** argv) {
                 problem.cplex.setParam(IloCplex::Param::MIP::Strategy::HeuristicFreq, -1);
                 problem.cplex.setParam(IloCplex::Param::MIP::Strategy::RINSHeur, -1);
                 problem.cplex.setParam(IloCplex::Param::MIP::Strategy::LBHeur, false);
-
-                // Load general heuristic parameters
-                heuristic_params.add("verbose", options["verbose"].as<bool>());
-                heuristic_params.add("seed", options["seed"].as<unsigned long>());
-                heuristic_params.add("submip-nodes-limit", options["submip-nodes-limit"].as<long>());
-                if (options.count("submip-nodes-unsuccessful") > 0) {
-                    heuristic_params.add("submip-nodes-unsuccessful", options["submip-nodes-unsuccessful"].as<long>());
-                }
-
-                // Set the heuristic chosen by the user
-                if (options["heuristic"].as<std::string>().compare("maravilha") == 0) {
-
-                    // Load Maravilha's heuristic parameters
-                    heuristic_params.add("iterations", options["maravilha-iterations"].as<long>());
-                    heuristic_params.add("submip-min", options["maravilha-submip-min"].as<double>());
-                    heuristic_params.add("submip-max", options["maravilha-submip-max"].as<double>());
-                    heuristic_params.add("offset", options["maravilha-offset"].as<double>());
-
-                    // Instantiate the heuristic
-                    heuristic = new orcs::Maravilha(&problem, &pool, &heuristic_params);
-
-                } else if (options["heuristic"].as<std::string>().compare("rothberg") == 0) {
-
-                    // Load Rothberg's heuristic parameters
-                    heuristic_params.add("recombinations", options["rothberg-recombinations"].as<long>());
-                    heuristic_params.add("mutations", options["rothberg-mutations"].as<long>());
-                    heuristic_params.add("fixing-fraction", options["rothberg-fixing-fraction"].as<double>());
-                    heuristic_params.add("offset-init", options["rothberg-offset-init"].as<double>());
-                    heuristic_params.add("offset-reduction", options["rothberg-offset-reduction"].as<double>());
-                    heuristic_params.add("offset-minimum", options["rothberg-offset-minimum"].as<double>());
-
-                    // Instantiate the heuristic
-                    heuristic = new orcs::Rothberg(&problem, &pool, &heuristic_params);
-
-                }
             }
         }
 
         // Heuristic
         long heuristic_frequency = options["heuristic-frequency"].as<long>();
-        problem.cplex.use(orcs::HeuristicCallback::create_instance(env, heuristic,
-                heuristic_frequency, &timer, time_limit));
+        problem.cplex.use(orcs::HeuristicCallback::create_instance(env, heuristic, &pool,
+                problem.variables, heuristic_frequency, &timer, time_limit, broadcast));
+
+        // Guide the branching by the agreement of the solutions in the pool
+        if (options.count("pool-branching") > 0) {
+            problem.cplex.use(orcs::PoolBranchCallback::create_instance(env, &pool, problem.variables,
+                    options["pool-branching-frequency"].as<long>(),
+                    options["pool-branching-agreement"].as<double>()));
+        }
+
+        if (checkpointer != nullptr) {
+            checkpointer->set_phase(2, result_before_heuristic.runtime,
+                    result_before_heuristic.mip_nodes_explored, heuristic);
+        }
 
         // Resume the optimization process (2nd phase: heuristic)
         timer.start();
@@ -272,6 +577,8 @@ int main(int argc, char** argv) {
 
         // Get result
         Result result_after_heuristic = get_result(problem, pool, timer);
+        result_after_heuristic.runtime += time_offset;
+        result_after_heuristic.mip_nodes_explored += nodes_offset;
 
         // Display results
         print_results(problem, result_before_heuristic, result_after_heuristic, options);
@@ -282,12 +589,34 @@ int main(int argc, char** argv) {
             problem.cplex.writeSolution(output_file.c_str());
         }
 
+        // Write statistics of the heuristic phase
+        if (options.count("stats") > 0) {
+            write_statistics(options["stats"].as<std::string>(), heuristic,
+                    result_before_heuristic, result_after_heuristic, options);
+        }
+
+        // Write the pool of solutions (to warm start later runs)
+        if (options.count("export-pool") > 0) {
+            orcs::PoolFile::write(options["export-pool"].as<std::string>(), pool, problem.variables);
+        }
+
         // Free resources
+        if (checkpointer != nullptr) {
+            delete checkpointer;
+            checkpointer = nullptr;
+        }
+
         if (heuristic != nullptr) {
             delete heuristic;
             heuristic = nullptr;
         }
 
+        if (symmetry != nullptr) {
+            pool.set_symmetry(nullptr);
+            delete symmetry;
+            symmetry = nullptr;
+        }
+
     } catch (const cxxopts::OptionException& e) {
         std::cerr << "Syntax error." << std::endl;
         std::cerr << e.what() << std::endl;
@@ -327,7 +656,14 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
             ("f,file", "Name of the file containing the model. Valid suffixes "
                      "are .MPS and .LP. Files can be compressed, so the additional "
                      "suffix .GZ is accepted.",
-             cxxopts::value<std::string>(), "FILE");
+             cxxopts::value<std::string>(), "FILE")
+            ("config", "Name of a configuration file with values of the options (in a "
+                     "subset of TOML). Options set in the command line take precedence over "
+                     "the ones in the file.",
+             cxxopts::value<std::string>(), "FILE")
+            ("param-set", "Name of the parameter set of the configuration file to use. "
+                     "Its values override the top-level values of the file.",
+             cxxopts::value<std::string>(), "NAME");
 
     options.add_options("Printing")
             ("v,verbose", "Display the progress of the optimization process "
@@ -336,6 +672,13 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
                     "the optimization process. Valid values are: 0, 1, 2, 3 and 4.",
                     cxxopts::value<int>()->default_value("1"), "VALUE")
             ("s,solution", "Name of the file to save with best solution found.",
+             cxxopts::value<std::string>(), "FILE")
+            ("stats", "Name of the file to save the statistics of the heuristic phase "
+                     "(sub-MIPs solved, improvements, throughput and peak memory) in JSON "
+                     "format.",
+             cxxopts::value<std::string>(), "FILE")
+            ("export-pool", "Name of the file to save the pool of solutions found (which can warm "
+                     "start later runs with the option --warm-pool).",
              cxxopts::value<std::string>(), "FILE");
 
     options.add_options("General")
@@ -357,6 +700,15 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
                      "and it is called the first time at node 1000, then it will be called at nodes "
                      "1100, 1200 and so on. If set to zero, the heuristic will not be called.",
              cxxopts::value<long>()->default_value("1"), "VALUE")
+            ("pool-branching", "Guide the branching of the optimization process using the MIP "
+                     "heuristic by the agreement of the solutions in the pool on each binary variable.")
+            ("pool-branching-frequency", "Number of MIP nodes between updates of the agreement of "
+                     "the pool used to guide the branching.",
+             cxxopts::value<long>()->default_value("100"), "VALUE")
+            ("pool-branching-agreement", "Minimum agreement of the pool on a binary variable to "
+                     "branch on it. It must be a value between 0 (half of the solutions assign each "
+                     "value to the variable) and 1 (all solutions assign the same value to it).",
+             cxxopts::value<double>()->default_value("0.8"), "VALUE")
             ("heuristic-nodes-limit", "Additional MIP nodes to continue the optimization "
                      "process using the MIP heuristic. If not set, this stopping criterion is ignored.",
              cxxopts::value<long>(), "VALUE")
@@ -371,6 +723,21 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
                      "will continue for another 100 seconds performing the heuristic search. If not set, this "
                      "stopping criterion is ignored.",
              cxxopts::value<double>(), "VALUE")
+            ("stall-window", "Abort the optimization process using the MIP heuristic when the "
+                     "relative MIP gap closed over the last VALUE seconds is less than stall-progress. "
+                     "If not set, this stopping criterion is ignored.",
+             cxxopts::value<double>(), "VALUE")
+            ("stall-progress", "Minimum relative MIP gap closed over the window of stall-window seconds.",
+             cxxopts::value<double>()->default_value("0.001"), "VALUE")
+            ("checkpoint", "Name of the file to save periodic checkpoints of the optimization "
+                     "process (pool of solutions, state of the heuristic, time and MIP nodes "
+                     "spent), so that an interrupted run can be resumed.",
+             cxxopts::value<std::string>(), "FILE")
+            ("checkpoint-interval", "Time (in seconds) between checkpoints.",
+             cxxopts::value<double>()->default_value("60"), "VALUE")
+            ("resume", "Resume the optimization process from the checkpoint file (set by "
+                     "--checkpoint), if it exists. The remaining budgets (time and MIP nodes) "
+                     "are the ones left by the interrupted run.")
             ("submip-nodes-limit", "Maximum number of MIP nodes explored by each sub-MIP "
                      "problem solved by a MIP heuristic.",
              cxxopts::value<long>()->default_value("500"), "VALUE")
@@ -378,8 +745,130 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
                      "without improvement in the sub-MIP incumbent solution. If not set, "
                      "this stopping criteria is ignored.",
              cxxopts::value<long>(), "VALUE")
+            ("submip-early-exit", "Abort each sub-MIP as soon as its incumbent solution improves "
+                     "the global incumbent solution by this relative margin (e.g., 0 aborts on the "
+                     "first improvement). If not set, sub-MIPs run until their stopping criteria.",
+             cxxopts::value<double>(), "VALUE")
+            ("submip-live-cutoff", "Publish the incumbent solutions of the branch-and-cut and of "
+                     "every sub-MIP into a global incumbent, and abort each sub-MIP as soon as its "
+                     "best bound cannot beat a better solution found by a concurrent search. It "
+                     "currently has no effect, since no search runs concurrently with sub-MIPs.")
+            ("submip-stall-window", "Abort each sub-MIP when the relative MIP gap closed over "
+                     "its last VALUE nodes is less than submip-stall-progress. If not set, this stopping "
+                     "criterion is ignored.",
+             cxxopts::value<long>(), "VALUE")
+            ("submip-stall-progress", "Minimum relative MIP gap closed over the window of "
+                     "submip-stall-window nodes.",
+             cxxopts::value<double>()->default_value("0.001"), "VALUE")
+            ("submip-pool-starts", "Set every solution of the pool that agrees with the "
+                     "fixings of a sub-MIP as an additional MIP start of the sub-MIP.")
+            ("submip-widening-steps", "Maximum number of times a sub-MIP solved to optimality "
+                     "without improvement is widened (a batch of fixed variables is freed) and solved "
+                     "again, warm started from its previous solution. If set to zero, sub-MIPs are not "
+                     "widened.",
+             cxxopts::value<long>()->default_value("0"), "VALUE")
+            ("submip-widening-batch", "Proportion of binary variables freed at each time a sub-MIP "
+                     "is widened. It must be a value between 0 and 1.",
+             cxxopts::value<double>()->default_value("0.05"), "VALUE")
+            ("submip-split-components", "Split each sub-MIP into the connected components of "
+                     "its free variables (regarding the constraints they share) and solve each "
+                     "component as an independent sub-MIP.")
+            ("submip-component-min-size", "Minimum number of free variables of each independent "
+                     "sub-MIP when splitting sub-MIPs into components. Smaller components are "
+                     "grouped together.",
+             cxxopts::value<long>()->default_value("50"), "VALUE")
+            ("submip-workers", "Number of threads used to solve independent components of "
+                     "sub-MIPs in parallel. If set to zero, components are solved one after another.",
+             cxxopts::value<long>()->default_value("0"), "VALUE")
+            ("submip-backend", "MIP solver used by the workers to solve independent components "
+                     "of sub-MIPs. Valid values are: cplex, highs (requires a build with HiGHS "
+                     "support) and auto (HiGHS for small components and CPLEX for the others). "
+                     "Backends other than cplex require --submip-split-components and "
+                     "--submip-workers greater than zero.",
+             cxxopts::value<std::string>()->default_value("cplex"), "VALUE")
+            ("submip-backend-threshold", "Maximum number of free variables of a component solved "
+                     "by HiGHS when the sub-MIP backend is auto.",
+             cxxopts::value<long>()->default_value("1000"), "VALUE")
+            ("submip-lp-polishing", "In mixed problems, polish the continuous part of each "
+                     "solution of a sub-MIP not solved to optimality by fixing its integer variables "
+                     "and solving the remaining LP (warm started from the previous one).")
+            ("submip-recursion-depth", "Maximum depth of recursive polishing: a sub-MIP with at "
+                     "least submip-recursion-min-size free variables is explored by a nested heuristic "
+                     "(of the same kind) solving smaller sub-MIPs from its search tree. If set to zero, "
+                     "sub-MIPs are never explored recursively.",
+             cxxopts::value<long>()->default_value("0"), "VALUE")
+            ("submip-recursion-min-size", "Minimum number of free variables of a sub-MIP explored "
+                     "by a nested heuristic.",
+             cxxopts::value<long>()->default_value("1000"), "VALUE")
+            ("submip-recursion-frequency", "Frequency (in MIP nodes of the sub-MIP) the nested "
+                     "heuristic is called.",
+             cxxopts::value<long>()->default_value("50"), "VALUE")
+            ("placement", "Policy used to pin the main search and the sub-MIP workers to cores. "
+                     "Valid values are: none (threads are not pinned), compact (cores of a NUMA node "
+                     "are filled before moving to the next node) and scatter (threads alternate among "
+                     "NUMA nodes).",
+             cxxopts::value<std::string>()->default_value("none"), "VALUE")
+            ("huge-pages", "Back large arrays (e.g., the constraint matrix used by the heuristics) "
+                     "with transparent huge pages.")
+            ("constructive-attempts", "Number of attempts of the fix-and-propagate constructive "
+                     "heuristic run before the 1st phase to seed the pool of solutions and the MIP "
+                     "starts. If set to zero, the constructive heuristic is not used.",
+             cxxopts::value<long>()->default_value("0"), "VALUE")
+            ("constructive-threads", "Number of threads that run the attempts of the constructive "
+                     "heuristic.",
+             cxxopts::value<long>()->default_value("1"), "VALUE")
+            ("constructive-order", "Order in which the constructive heuristic fixes the integer "
+                     "variables. Valid values are: random (random order, each variable fixed to the "
+                     "bound preferred by the objective function) and relaxation (the most integral "
+                     "variables in the LP relaxation first, fixed to their rounded values).",
+             cxxopts::value<std::string>()->default_value("random"), "VALUE")
+            ("constructive-candidates", "Number of attempts of the constructive heuristic (the "
+                     "ones with fewest conflicts) that are completed or repaired by a sub-MIP.",
+             cxxopts::value<long>()->default_value("10"), "VALUE")
+            ("constructive-repair-nodes", "Maximum number of MIP nodes explored by each repair "
+                     "sub-MIP of the constructive heuristic.",
+             cxxopts::value<long>()->default_value("500"), "VALUE")
+            ("constructive-time-limit", "Time limit (in seconds) of the constructive heuristic.",
+             cxxopts::value<double>()->default_value("10"), "VALUE")
+            ("warm-pool", "Name of a file with the pool of solutions of a previous run (saved with "
+                     "the option --export-pool), possibly of a modified version of the problem. Its "
+                     "solutions are mapped onto the problem by the names of the variables, repaired "
+                     "as the attempts of the constructive heuristic (with its threads, repair nodes "
+                     "and time limit) and used to seed the pool of solutions and the MIP starts.",
+             cxxopts::value<std::string>(), "FILE")
+            ("fixing-strategy", "Strategy used by MIP heuristics to choose the binary variables "
+                     "to fix on sub-MIP problems. Valid values are: random, reduced-cost, pseudo-cost "
+                     "and combined.",
+             cxxopts::value<std::string>()->default_value("random"), "VALUE")
+            ("sampling", "How MIP heuristics sample the binary variables kept free on sub-MIP "
+                     "problems. Valid values are: independent (variables are sampled independently "
+                     "of each other) and connected (free variables are grown along the constraints "
+                     "they share).",
+             cxxopts::value<std::string>()->default_value("independent"), "VALUE")
+            ("predictor-threshold", "Minimum probability of success (predicted by an online "
+                     "logistic regression on features of the neighborhood) of a sub-MIP to be solved. "
+                     "Neighborhoods below it are resampled before any call to the solver. If set to "
+                     "zero, the predictor is disabled.",
+             cxxopts::value<double>()->default_value("0"), "VALUE")
+            ("predictor-resamples", "Maximum number of neighborhoods resampled in a row by "
+                     "the success predictor (the last one is solved anyway).",
+             cxxopts::value<long>()->default_value("3"), "VALUE")
+            ("predictor-learning-rate", "Learning rate of the success predictor.",
+             cxxopts::value<double>()->default_value("0.05"), "VALUE")
+            ("predictor-warmup", "Number of neighborhoods solved before the success predictor "
+                     "starts to resample neighborhoods.",
+             cxxopts::value<long>()->default_value("20"), "VALUE")
+            ("predictor-exploration", "Probability of solving a neighborhood regardless of its "
+                     "predicted success (so the predictor keeps learning about all kinds of "
+                     "neighborhoods).",
+             cxxopts::value<double>()->default_value("0.1"), "VALUE")
             ("pool-size", "The maximum number of solutions kept in the pool of solutions.",
-             cxxopts::value<long>()->default_value("40"), "VALUE");
+             cxxopts::value<long>()->default_value("40"), "VALUE")
+            ("pool-symmetry", "Detect the formulation symmetry of the problem and reject "
+                     "solutions that are images of the ones in the pool of solutions under a "
+                     "symmetry found. Generators are searched by individualization-refinement "
+                     "with a limited budget and checked against the formulation, so symmetric "
+                     "solutions may be missed, but distinct ones are never rejected.");
 
     options.add_options("Maravilha's heuristic")
             ("maravilha-iterations", "Number of sub-MIPs to solve each time Maravilha's MIP "
@@ -393,11 +882,20 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
              cxxopts::value<double>()->default_value("0.65"), "VALUE")
             ("maravilha-offset", "Value used to auto-adjust (increase/decrease) the size limits of sub-MIPs. "
                      "It must be a value between 0 and 1.",
-             cxxopts::value<double>()->default_value("0.45"), "VALUE");
+             cxxopts::value<double>()->default_value("0.45"), "VALUE")
+            ("maravilha-relaxation-cache", "Maximum number of (diverse) LP relaxations of "
+                     "previous nodes kept as guides for sub-MIPs. If set to zero, sub-MIPs are "
+                     "guided by the LP relaxation of the current node only.",
+             cxxopts::value<long>()->default_value("0"), "VALUE")
+            ("maravilha-relaxation-diversity", "Minimum normalized distance (regarding the binary "
+                     "variables) of a LP relaxation to the incumbent solution and to the relaxations "
+                     "in the cache to be kept. It must be a value between 0 and 1.",
+             cxxopts::value<double>()->default_value("0.05"), "VALUE");
 
     options.add_options("Rothberg's heuristic")
             ("rothberg-recombinations", "Number of recombination sub-MIP problems solved "
-                     "at each time Rothberg's MIP heuristic is performed.",
+                     "at each time Rothberg's MIP heuristic is performed. If set to zero, "
+                     "recombinations are not performed.",
              cxxopts::value<long>()->default_value("40"), "VALUE")
             ("rothberg-mutations", "Number of mutation sub-MIP problems solved at each "
                      "time Rothberg's MIP heuristic is performed.",
@@ -413,12 +911,56 @@ cxxopts::Options create_command_parser(int argc, char** argv) {
              cxxopts::value<double>()->default_value("0.25"), "VALUE")
             ("rothberg-offset-minimum", "The lowest value the offset can take. It must be "
                      "a value between 0 and 1.",
-             cxxopts::value<double>()->default_value("0.01"), "VALUE");
+             cxxopts::value<double>()->default_value("0.01"), "VALUE")
+            ("rothberg-neighborhood", "Neighborhood explored by mutation sub-MIPs. Valid values "
+                     "are: fixing (a fraction of the binary variables is fixed) and local-branching "
+                     "(all binary variables are kept free and a local branching constraint limits "
+                     "the number of binary variables that flip their values).",
+             cxxopts::value<std::string>()->default_value("fixing"), "VALUE")
+            ("rothberg-batch", "Number of fixing neighborhoods generated at once, as bitmasks over "
+                     "the bit-packed solutions of the pool (repeated neighborhoods are discarded). "
+                     "Mutations are batched only with random fixing and independent sampling, and the "
+                     "fixing fraction adapted after each mutation only applies from the next batch (so "
+                     "the adaptation lags by up to <VALUE> sub-MIPs). If set to one, neighborhoods are "
+                     "generated one at a time.",
+             cxxopts::value<long>()->default_value("1"), "VALUE");
+
+    // Arguments of the configuration file (if any) are placed before the
+    // ones of the command line, so that the latter take precedence
+    std::vector<std::string> args(argv, argv + argc);
+    std::string config_file = find_argument(argc, argv, "config");
+    if (!config_file.empty()) {
+        orcs::ConfigFile config(config_file);
+        std::vector<std::string> config_args = config.arguments(find_argument(argc, argv, "param-set"));
+        args.insert(args.begin() + 1, config_args.begin(), config_args.end());
+    }
+
+    std::vector<char*> args_ptr;
+    for (auto& arg : args) {
+        args_ptr.push_back(&arg[0]);
+    }
 
-    options.parse(argc, argv);
+    int args_count = args_ptr.size();
+    char** args_values = args_ptr.data();
+    options.parse(args_count, args_values);
     return options;
 }
 
+std::string find_argument(int argc, char** argv, const std::string& name) {
+    std::string value;
+    std::string option = "--" + name;
+    for (int k = 1; k < argc; ++k) {
+        std::string arg(argv[k]);
+        if (arg == option && k + 1 < argc) {
+            value = argv[++k];
+        } else if (arg.compare(0, option.size() + 1, option + "=") == 0) {
+            value = arg.substr(option.size() + 1);
+        }
+    }
+
+    return value;
+}
+
 void print_command_help(const cxxopts::Options& options, std::ostream& output) {
     output << options.help({"","Printing","General","Maravilha's heuristic","Rothberg's heuristic"})
            << std::endl;
@@ -631,3 +1173,94 @@ void print_details_4(orcs::ProblemData& problem, const Result& before, const Res
     std::printf("Time in sec. (total):             %.3lf\n", after.runtime);
     std::printf("======================================================================\n\n");
 }
+
+void write_statistics(const std::string& filename, const orcs::Heuristic* heuristic,
+                      const Result& before, const Result& after, const cxxopts::Options& options) {
+
+    std::ofstream output(filename);
+    if (!output) {
+        throw std::string("Invalid statistics file.");
+    }
+
+    // Quote a string as a JSON value
+    auto quote = [](const std::string& value) {
+        std::string quoted = "\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    };
+
+    // Objective values (null, if no feasible solution is known)
+    auto objective = [](const Result& result) {
+        if (result.status == IloAlgorithm::Status::Feasible || result.status == IloAlgorithm::Status::Optimal) {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.5lf", result.objective_value);
+            return std::string(buffer);
+        }
+        return std::string("null");
+    };
+
+    std::string status = "Unknown";
+    switch (after.status) {
+        case IloAlgorithm::Status::Feasible:
+            status = "Feasible";
+            break;
+        case IloAlgorithm::Status::Optimal:
+            status = "Optimal";
+            break;
+        case IloAlgorithm::Status::Infeasible:
+            status = "Infeasible";
+            break;
+        case IloAlgorithm::Status::Unbounded:
+            status = "Unbounded";
+            break;
+        case IloAlgorithm::Status::InfeasibleOrUnbounded:
+            status = "Infeasible_or_Unbounded";
+            break;
+        case IloAlgorithm::Status::Error:
+            status = "Error";
+            break;
+        default:
+            status = "Unknown";
+    }
+
+    // Work done by the heuristic and its throughput
+    orcs::HeuristicStatistics statistics;
+    if (heuristic != nullptr) {
+        statistics = heuristic->statistics();
+    }
+
+    double heuristic_time = after.runtime - before.runtime;
+    double submips_per_second = (heuristic_time > 0.0 ? statistics.submips / heuristic_time : 0.0);
+    double improvements_per_second = (heuristic_time > 0.0 ? statistics.improvements / heuristic_time : 0.0);
+
+    // Peak resident memory of the process (in kilobytes)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    output << "{\n";
+    output << "  \"file\": " << quote(options["file"].as<std::string>()) << ",\n";
+    output << "  \"heuristic\": " << quote(options["heuristic"].as<std::string>()) << ",\n";
+    output << "  \"seed\": " << options["seed"].as<unsigned long>() << ",\n";
+    output << "  \"pool_size\": " << options["pool-size"].as<long>() << ",\n";
+    output << "  \"submip_workers\": " << options["submip-workers"].as<long>() << ",\n";
+    output << "  \"status\": " << quote(status) << ",\n";
+    output << "  \"objective_before\": " << objective(before) << ",\n";
+    output << "  \"objective_after\": " << objective(after) << ",\n";
+    output << "  \"nodes_before\": " << before.mip_nodes_explored << ",\n";
+    output << "  \"nodes_after\": " << after.mip_nodes_explored << ",\n";
+    output << "  \"time_before\": " << before.runtime << ",\n";
+    output << "  \"time_heuristic\": " << heuristic_time << ",\n";
+    output << "  \"heuristic_calls\": " << statistics.calls << ",\n";
+    output << "  \"submips\": " << statistics.submips << ",\n";
+    output << "  \"improvements\": " << statistics.improvements << ",\n";
+    output << "  \"skipped\": " << statistics.skipped << ",\n";
+    output << "  \"submips_per_second\": " << submips_per_second << ",\n";
+    output << "  \"improvements_per_second\": " << improvements_per_second << ",\n";
+    output << "  \"peak_memory_kb\": " << usage.ru_maxrss << "\n";
+    output << "}\n";
+}
@@ -1,25 +1,32 @@
 #include "maravilha.h"
-#include "abort_callback.h"
 #include <cmath>
+#include <string>
 #include <limits>
+#include <iomanip>
 
 
-orcs::Maravilha::Maravilha(ProblemData* problem, SolutionPool* pool,
-        const cxxproperties::Properties* params) :
-        problem_(problem), submip_(problem->env, problem->filename),
-        pool_(pool), differences_(problem_->variables.getSize(), 0.0)
+orcs::Maravilha::Maravilha(ProblemData* problem, const HeuristicParameters& params,
+        const MaravilhaParameters& maravilha_params) :
+        pool_(nullptr), problem_(problem), submip_(problem->filename),
+        submip_solver_(&submip_, params.submip),
+        fixing_scores_(problem, params.fixing_strategy, submip_.variables.getSize()),
+        predictor_(params.predictor),
+        relaxation_cache_(maravilha_params.relaxation_cache, maravilha_params.relaxation_diversity),
+        differences_(submip_.variables.getSize(), 0.0)
 {
 
     // Heuristic parameters
-    iterations_ = params->get<long>("iterations", 1L);
-    submip_min_ = params->get<double>("submip-min", 0.00);
-    submip_max_ = params->get<double>("submip-max", 0.65);
-    offset_ = params->get<double>("offset", 0.45);
+    iterations_ = maravilha_params.iterations;
+    submip_min_ = maravilha_params.submip_min;
+    submip_max_ = maravilha_params.submip_max;
+    offset_ = maravilha_params.offset;
+    connected_sampling_ = params.connected_sampling;
+    widening_steps_ = params.submip.widening_steps;
+    widening_batch_ = params.submip.widening_batch;
 
     // Other parameters
-    seed_ = params->get<int>("seed", 0);
-    submip_nodes_limit_ = params->get<long>("submip-nodes-limit", 500);
-    submip_nodes_unsuccessful_ = params->get<long>("submip-nodes-unsuccessful", std::numeric_limits<long>::max());
+    seed_ = params.submip.seed;
+    submip_nodes_limit_ = params.submip.nodes_limit;
 
     // Set CPLEX instance used to solve sub-MIPs
     submip_.cplex.setOut(submip_.env.getNullStream());
@@ -32,42 +39,87 @@ orcs::Maravilha::Maravilha(ProblemData* problem, SolutionPool* pool,
     submip_.cplex.setParam(IloCplex::Param::MIP::Strategy::RINSHeur, 0);
     submip_.cplex.setParam(IloCplex::Param::MIP::Strategy::LBHeur, false);
 
-    // Identify binary variables
-    for (std::size_t i = 0; i < problem_->variables.getSize(); ++i) {
-        if (problem_->variables[i].getType() == IloNumVar::Type::Bool || 
-                (problem_->variables[i].getType() == IloNumVar::Type::Int && 
-                std::abs(problem_->variables[i].getLB()) < THRESHOLD && 
-                std::abs(problem_->variables[i].getUB() - 1.0) < THRESHOLD)) {
+    // Identify binary variables (on the copy of the problem, since the
+    // heuristic may be built while the problem is being solved)
+    for (std::size_t i = 0; i < (std::size_t) submip_.variables.getSize(); ++i) {
+        if (submip_.variables[i].getType() == IloNumVar::Type::Bool || 
+                (submip_.variables[i].getType() == IloNumVar::Type::Int && 
+                std::abs(submip_.variables[i].getLB()) < THRESHOLD && 
+                std::abs(submip_.variables[i].getUB() - 1.0) < THRESHOLD)) {
             binary_variables_.push_back(i);
         }
     }
 
+    // Nested heuristic (recursive polishing), which explores large sub-MIPs
+    // by smaller ones on its own copy of the problem (nested sub-MIPs are not
+    // split into components, to bound the number of copies of the problem)
+    nested_ = nullptr;
+    if (params.submip.recursion_depth > 0) {
+        HeuristicParameters nested_params = params;
+        nested_params.submip.recursion_depth -= 1;
+        nested_params.submip.seed += 1;
+        nested_params.submip.split_components = false;
+        nested_params.submip.workers = 0;
+        nested_ = new Maravilha(&submip_, nested_params, maravilha_params);
+        submip_solver_.set_nested(nested_);
+    }
+
     // Initialize the random number generator
     random_.seed(seed_);
 }
 
-void orcs::Maravilha::run(IloCplex::HeuristicCallbackI* callback,
-        const cxxtimer::Timer* timer, double time_limit) {
+orcs::Maravilha::~Maravilha() {
+    if (nested_ != nullptr) {
+        delete nested_;
+    }
+}
+
+void orcs::Maravilha::run(const HeuristicContext& context) {
+
+    // Need a pool and an incumbent solution
+    if (context.pool == nullptr || context.incumbent.empty()) {
+        return;
+    }
+
+    ++statistics_.calls;
+
+    // Solutions of the pool may be used as MIP starts of sub-MIPs
+    pool_ = context.pool;
+    submip_solver_.set_pool(pool_, &binary_variables_);
+
+    // Sub-MIPs are preempted by better solutions found elsewhere
+    submip_solver_.set_broadcast(context.broadcast);
 
     // Need at least one feasible solution
     if (pool_->size() > 0) {
 
         // Get the incumbent solution
-        double incumbent_objective = callback->getIncumbentObjValue();
+        double incumbent_objective = context.incumbent_objective;
         IloNumArray incumbent_solution(problem_->env, problem_->variables.getSize());
-        callback->getIncumbentValues(incumbent_solution, problem_->variables);
+        for (std::size_t j = 0; j < (std::size_t) incumbent_solution.getSize(); ++j) {
+            incumbent_solution[j] = context.incumbent[j];
+        }
 
-        // Get the relaxed solution from the current node
-        double relaxed_objective = callback->getObjValue();
+        // Get the relaxed solution (e.g., from the current node); without a
+        // relaxation, the sub-MIPs are guided by the incumbent only
+        bool has_relaxation = !context.relaxation.empty();
+        double relaxed_objective = (has_relaxation ? context.relaxation_objective : incumbent_objective);
         IloNumArray relaxed_solution(problem_->env, problem_->variables.getSize());
-        callback->getValues(relaxed_solution, problem_->variables);
+        for (std::size_t j = 0; j < (std::size_t) relaxed_solution.getSize(); ++j) {
+            relaxed_solution[j] = (has_relaxation ? context.relaxation[j] : context.incumbent[j]);
+        }
+
+        // Keep the relaxation, if it is diverse enough, as a guide for later
+        // calls (consecutive nodes usually have near-identical relaxations)
+        relaxation_cache_.offer(relaxed_solution, relaxed_objective, incumbent_solution, binary_variables_);
+        IloNumArray guide_solution(problem_->env, problem_->variables.getSize());
 
         // Create and solve sub-MIPs
         long current_iteration = 0;
         while (current_iteration < iterations_) {
 
             // Check timer (stop criterion)
-            if (timer != nullptr && (timer->count<std::chrono::milliseconds>() / 1000.0) >= time_limit) {
+            if (context.expired()) {
                 break;
             }
 
@@ -81,15 +133,27 @@ void orcs::Maravilha::run(IloCplex::HeuristicCallbackI* callback,
             std::size_t idx_pool = (random_() % pool_->size());
             const SolutionPool::Entry &entry = pool_->get_entries()[idx_pool];
 
+            // Select the relaxation that guides the sub-MIP (from the cache,
+            // if enabled, or from the current node)
+            const IloNumArray* guide = &relaxed_solution;
+            double guide_objective = relaxed_objective;
+            if (relaxation_cache_.size() > 0) {
+                guide_objective = relaxation_cache_.sample(random_, guide_solution, binary_variables_);
+                guide = &guide_solution;
+            }
+
             // Define the bias parameter (by GAP)
             double feas_bias = (entry.value - incumbent_objective) / (1e-5 + std::abs(incumbent_objective));
             feas_bias = 1.0 - std::max(0.0, std::min(1.0, feas_bias));
 
-            double rel_bias = (incumbent_objective - relaxed_objective) / (1e-5 + std::abs(relaxed_objective));
+            double rel_bias = (incumbent_objective - guide_objective) / (1e-5 + std::abs(guide_objective));
             rel_bias = 1.0 - std::max(0.0, std::min(1.0, rel_bias));
 
             double bias = 1 - (feas_bias / (feas_bias + rel_bias));
 
+            // Score how safe is fixing each binary variable to its incumbent value
+            fixing_scores_.update(context, incumbent_solution, binary_variables_);
+
             // Process information about each binary variable
             double sum_differences = 0.0;
             for (auto idx : binary_variables_) {
@@ -101,7 +165,12 @@ void orcs::Maravilha::run(IloCplex::HeuristicCallbackI* callback,
 
                 // Compute the biased differences
                 differences_[idx] = bias * std::abs(incumbent_solution[idx] - entry.solution[idx]) +
-                        (1 - bias) * std::abs(incumbent_solution[idx] - relaxed_solution[idx]);
+                        (1 - bias) * std::abs(incumbent_solution[idx] - (*guide)[idx]);
+
+                // Variables that are safe to fix are less likely to be free
+                if (fixing_scores_.strategy() != FixingScores::Strategy::RANDOM) {
+                    differences_[idx] *= (1.0 - fixing_scores_[idx]);
+                }
 
                 sum_differences += differences_[idx];
             }
@@ -115,80 +184,104 @@ void orcs::Maravilha::run(IloCplex::HeuristicCallbackI* callback,
                     (binary_variables_.size() * ((submip_min_ + submip_max_) / 2.0)));
 
             // Build the sub-MIP
-            for (std::size_t count = 0; count < submip_size; ++count) {
+            if (connected_sampling_) {
 
-                // Select a binary variable
-                double rand_value = (random_() / (double) random_.max()) * sum_differences;
-                double acc = 0.0;
+                // Grow the set of free variables along the constraints, seeded
+                // by (and biased to) the variables with larger differences
+                sampler_.sample(submip_solver_.graph(), binary_variables_, differences_,
+                        submip_size, random_, selected_);
 
-                for (auto idx : variables_available_) {
-                    acc += differences_[idx];
-                    if (acc >= rand_value) {
+                for (auto idx : selected_) {
+                    submip_.variables[idx].setLB(problem_->variables[idx].getLB());
+                    submip_.variables[idx].setUB(problem_->variables[idx].getUB());
+                }
 
-                        // Make the binary variable free for optimization
-                        submip_.variables[idx].setLB(problem_->variables[idx].getLB());
-                        submip_.variables[idx].setUB(problem_->variables[idx].getUB());
+                // Remove the free variables from the available ones
+                for (auto idx : selected_) {
+                    sum_differences -= differences_[idx];
+                    variables_available_.erase(idx);
+                }
 
-                        // Remove the variable from the available ones
-                        sum_differences -= differences_[idx];
-                        variables_available_.erase(idx);
+            } else {
+                free_variables(submip_size, sum_differences);
+            }
 
-                        break;
-                    }
+            // Resample the neighborhood, if it is unlikely to succeed (the
+            // seed gap is the one of the solution of the pool that biases it)
+            SuccessPredictor::Features features;
+            if (predictor_.enabled()) {
+                features = predictor_.describe(submip_, binary_variables_, incumbent_solution,
+                        entry.value, incumbent_objective, *pool_, context.relaxation,
+                        SuccessPredictor::Operator::FIXING);
+                if (!predictor_.accept(features, random_)) {
+                    --current_iteration;
+                    continue;
                 }
             }
 
-            // Extract sub-MIP model into CPLEX solver
-            submip_.cplex.extract(submip_.model);
-
-            // Set a MIP start solution
-            submip_.cplex.addMIPStart(submip_.variables, incumbent_solution);
-
-            // Set sub-MIP abort callback
-            submip_.cplex.use(orcs::AbortCallback::create_instance(submip_.env, timer,
-                    time_limit, std::numeric_limits<unsigned long long>::max(),
-                    submip_nodes_unsuccessful_));
-
-            // Optimize the sub-MIP
-            bool submip_found_solution = submip_.cplex.solve();
-            IloAlgorithm::Status submip_status = submip_.cplex.getStatus();
+            // Optimize the sub-MIP (with the incumbent as MIP start solution)
+            submip_solver_.set_incumbent(incumbent_objective);
+            bool submip_found_solution = submip_solver_.solve(incumbent_solution,
+                    &incumbent_solution, context.timer, context.time_limit);
+            IloAlgorithm::Status submip_status = submip_solver_.status();
 
-            // Check if some solution was found
             bool submip_has_improved = false;
-            if (submip_found_solution) {
+            long widening_step = 0;
+            while (true) {
 
-                // Get the solution
-                SolutionPool::Entry current_entry {
-                        IloNumArray(submip_.env, submip_.variables.getSize()),
-                        submip_.cplex.getObjValue(), 0};
+                // Check if some solution was found
+                if (submip_found_solution) {
 
-                submip_.cplex.getValues(current_entry.solution, submip_.variables);
+                    // Get the solution
+                    SolutionPool::Entry current_entry {
+                            submip_solver_.solution(), submip_solver_.objective(), 0};
 
-                // Update the solution pool
-                pool_->add_entry(current_entry.solution, current_entry.value);
+                    // Update the solution pool
+                    pool_->add_entry(current_entry.solution, current_entry.value);
 
-                // Check if the new solution is better than the current incumbent
-                if ((submip_.objective.getSense() == IloObjective::Minimize &&
-                     current_entry.value < incumbent_objective - THRESHOLD) ||
-                    (submip_.objective.getSense() == IloObjective::Maximize &&
-                     current_entry.value > incumbent_objective + THRESHOLD)) {
+                    // Check if the new solution is better than the current incumbent
+                    if ((submip_.objective.getSense() == IloObjective::Minimize &&
+                         current_entry.value < incumbent_objective - THRESHOLD) ||
+                        (submip_.objective.getSense() == IloObjective::Maximize &&
+                         current_entry.value > incumbent_objective + THRESHOLD)) {
 
-                    // Update the incumbent solution
-                    incumbent_objective = current_entry.value;
-                    for (std::size_t idx = 0; idx < incumbent_solution.getSize(); ++idx) {
-                        incumbent_solution[idx] = current_entry.solution[idx];
+                        // Update the incumbent solution
+                        incumbent_objective = current_entry.value;
+                        for (std::size_t idx = 0; idx < (std::size_t) incumbent_solution.getSize(); ++idx) {
+                            incumbent_solution[idx] = current_entry.solution[idx];
+                        }
+
+                        // Set flag of improved solution found
+                        submip_has_improved = true;
                     }
+                }
 
-                    // Set flag of improved solution found
-                    submip_has_improved = true;
+                // Widen the neighborhood if the sub-MIP has been solved to
+                // optimality without improvement (the same sub-MIP is solved
+                // again with a batch of variables freed)
+                if (submip_has_improved || widening_step >= widening_steps_ ||
+                        submip_status != IloAlgorithm::Status::Optimal ||
+                        !submip_solver_.resolvable() || variables_available_.empty() ||
+                        context.expired()) {
+                    break;
                 }
 
-                // Free resources
-                current_entry.solution.end();
+                ++widening_step;
+                free_variables(std::max<std::size_t>(1, (std::size_t) (binary_variables_.size() * widening_batch_)),
+                        sum_differences);
+                submip_found_solution = submip_solver_.resolve(context.timer, context.time_limit);
+                submip_status = submip_solver_.status();
             }
 
-            // Update the sub-MIP size (if necessary)
-            if (!submip_has_improved) {
+            // Learn from the outcome of the neighborhood (a sub-MIP preempted
+            // by a better solution found elsewhere is not a failure)
+            if (predictor_.enabled() && (submip_has_improved || !submip_solver_.preempted())) {
+                predictor_.update(features, submip_has_improved);
+            }
+
+            // Update the sub-MIP size (if necessary, and unless the sub-MIP
+            // was preempted, which says nothing about its size)
+            if (!submip_has_improved && !submip_solver_.preempted()) {
                 if (submip_status == IloAlgorithm::Status::Optimal ||
                         submip_status == IloAlgorithm::Status::Infeasible) {
 
@@ -203,11 +296,82 @@ void orcs::Maravilha::run(IloCplex::HeuristicCallbackI* callback,
             }
         }
 
-        // Let CPLEX know about the best solution
-        callback->setSolution(problem_->variables, incumbent_solution);
+        // Count the improvement of the incumbent solution
+        if (problem_->objective.getSense() == IloObjective::Minimize ?
+                incumbent_objective < context.incumbent_objective - THRESHOLD :
+                incumbent_objective > context.incumbent_objective + THRESHOLD) {
+            ++statistics_.improvements;
+        }
+
+        // Hand the best solution to the caller
+        if (context.submit) {
+            std::vector<double> best(incumbent_solution.getSize());
+            for (std::size_t j = 0; j < best.size(); ++j) {
+                best[j] = incumbent_solution[j];
+            }
+            context.submit(ValueSpan(best), incumbent_objective);
+        }
 
         // Free resources
         incumbent_solution.end();
         relaxed_solution.end();
+        guide_solution.end();
+    }
+}
+
+orcs::HeuristicStatistics orcs::Maravilha::statistics() const {
+    HeuristicStatistics statistics = statistics_;
+    statistics.submips = submip_solver_.num_solved();
+    statistics.skipped = predictor_.num_rejected();
+    if (nested_ != nullptr) {
+        statistics.submips += nested_->statistics().submips;
+        statistics.skipped += nested_->statistics().skipped;
+    }
+    return statistics;
+}
+
+void orcs::Maravilha::write_state(std::ostream& output) const {
+    output << std::setprecision(17) << submip_min_ << " " << submip_max_ << " " << offset_ << " "
+           << statistics_.calls << " " << statistics_.improvements << " " << random_ << "\n";
+    predictor_.write_state(output);
+    if (nested_ != nullptr) {
+        nested_->write_state(output);
+    }
+}
+
+void orcs::Maravilha::read_state(std::istream& input) {
+    input >> submip_min_ >> submip_max_ >> offset_ >> statistics_.calls >> statistics_.improvements >> random_;
+    if (!input) {
+        throw std::string("Invalid state of the heuristic.");
+    }
+    predictor_.read_state(input);
+    if (nested_ != nullptr) {
+        nested_->read_state(input);
+    }
+}
+
+void orcs::Maravilha::free_variables(std::size_t count, double& sum_differences) {
+
+    for (; count > 0 && !variables_available_.empty(); --count) {
+
+        // Select a binary variable
+        double rand_value = (random_() / (double) random_.max()) * sum_differences;
+        double acc = 0.0;
+
+        for (auto idx : variables_available_) {
+            acc += differences_[idx];
+            if (acc >= rand_value) {
+
+                // Make the binary variable free for optimization
+                submip_.variables[idx].setLB(problem_->variables[idx].getLB());
+                submip_.variables[idx].setUB(problem_->variables[idx].getUB());
+
+                // Remove the variable from the available ones
+                sum_differences -= differences_[idx];
+                variables_available_.erase(idx);
+
+                break;
+            }
+        }
     }
 }
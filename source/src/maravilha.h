@@ -4,12 +4,17 @@
 #include "problem_data.h"
 #include "solution_pool.h"
 #include "heuristic.h"
+#include "fixing_scores.h"
+#include "success_predictor.h"
+#include "submip_solver.h"
+#include "graph_sampler.h"
+#include "relaxation_cache.h"
+#include "parameters.h"
 #include <cstdlib>
 #include <random>
 #include <vector>
 #include <set>
 #include <ilcplex/ilocplex.h>
-#include <cxxproperties.hpp>
 
 ILOSTLBEGIN
 
@@ -26,34 +31,67 @@ class Maravilha : public Heuristic {
 public:
     
     /**
-     * Constructor.
+     * Constructor. It only reads the name of the file of the problem (the
+     * heuristic loads its own copy), so it may be called while the problem is
+     * being solved by another thread.
      * 
      * @param   problem
      *          Pointer to problem data.
-     * @param   pool
-     *          Pointer to solution pool.
      * @param   params
-     *          Pointer to a properties structure with the heuristic parameters.
+     *          The parameters shared by the heuristics.
+     * @param   maravilha_params
+     *          The parameters of Maravilha's heuristic.
      */
-    Maravilha(ProblemData* problem, SolutionPool* pool,
-              const cxxproperties::Properties* params = nullptr);
+    Maravilha(ProblemData* problem, const HeuristicParameters& params,
+            const MaravilhaParameters& maravilha_params);
     
     /**
      * Perform the heuristic search.
      * 
-     * @param   callback
-     *          A pointer to the heuristic callback class.
-     * @param   timer
-     *          The timer to get the elapsed time spent on the entire
-     *          optimization process.
-     * @param   time_limit
-     *          The time limit of the optimization process (in seconds).
+     * @param   context
+     *          The incumbent solution, relaxation, pool of solutions, deadline
+     *          and solution sink of this call.
      */
-    void run(IloCplex::HeuristicCallbackI* callback, const cxxtimer::Timer* timer,
-            double time_limit) override;
+    void run(const HeuristicContext& context) override;
+
+    /**
+     * Destructor.
+     */
+    virtual ~Maravilha();
+
+    /**
+     * Return the counters of the work done by the heuristic so far.
+     *
+     * @return  The statistics of the heuristic.
+     */
+    HeuristicStatistics statistics() const override;
+
+    /**
+     * Write the adapted parameters, the counters and the state of the random
+     * number generator of the heuristic.
+     *
+     * @param   output
+     *          The stream to write the state.
+     */
+    void write_state(std::ostream& output) const override;
+
+    /**
+     * Restore the state written by write_state.
+     *
+     * @param   input
+     *          The stream to read the state.
+     */
+    void read_state(std::istream& input) override;
 
 private:
 
+    /**
+     * Free (relax the bounds of) a number of binary variables of the sub-MIP,
+     * chosen among the available ones with probability proportional to their
+     * differences.
+     */
+    void free_variables(std::size_t count, double& sum_differences);
+
     /*
      * Internal data structures.
      */
@@ -61,7 +99,15 @@ private:
     SolutionPool* pool_;
     ProblemData* problem_;
     ProblemData submip_;
+    SubmipSolver submip_solver_;
+    Maravilha* nested_;
+    HeuristicStatistics statistics_;
     std::vector<std::size_t> binary_variables_;
+    FixingScores fixing_scores_;
+    SuccessPredictor predictor_;
+    GraphSampler sampler_;
+    std::vector<std::size_t> selected_;
+    RelaxationCache relaxation_cache_;
     std::set<std::size_t> variables_available_;
     std::vector<double> differences_;
 
@@ -72,13 +118,15 @@ private:
     double submip_min_;
     double submip_max_;
     double offset_;
+    bool connected_sampling_;
+    long widening_steps_;
+    double widening_batch_;
 
     /*
      * Other parameters.
      */
     int seed_;
     long submip_nodes_limit_;
-    long submip_nodes_unsuccessful_;
 };
 
 }
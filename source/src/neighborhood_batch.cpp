@@ -0,0 +1,202 @@
+#include "neighborhood_batch.h"
+#include <cmath>
+#include <algorithm>
+
+
+namespace {
+
+/*
+ * Bits of precision of the probability of the random masks.
+ */
+constexpr int PRECISION = 16;
+
+/*
+ * Number of draws (per neighborhood of a batch) before giving up on finding
+ * new neighborhoods.
+ */
+constexpr std::size_t MAX_DRAWS = 4;
+
+/*
+ * Mix the bits of a 64-bit value (finalizer of SplitMix64).
+ */
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * A random 64-bit word.
+ */
+std::uint64_t random_word(std::mt19937& random) {
+    return (std::uint64_t(random()) << 32) | std::uint64_t(random());
+}
+
+/*
+ * Mask of the valid bits of the last word of a vector of bits.
+ */
+std::uint64_t last_word_mask(std::size_t size) {
+    std::size_t used = size % 64;
+    return (used == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << used) - 1);
+}
+
+/*
+ * Index of a seed solution drawn as the ones of Rothberg's heuristic (better
+ * solutions are more likely).
+ */
+std::size_t draw_seed(std::size_t size, std::mt19937& random) {
+    std::size_t idx = random() % size;
+    return (idx != 0 ? random() % idx : idx);
+}
+
+}
+
+orcs::NeighborhoodBatch::NeighborhoodBatch(std::size_t capacity) :
+        capacity_(std::max<std::size_t>(1, capacity))
+{
+    // It does nothing here.
+}
+
+void orcs::NeighborhoodBatch::clear() {
+    pending_.clear();
+    generated_.clear();
+}
+
+void orcs::NeighborhoodBatch::encode(const SolutionPool& pool, const std::vector<std::size_t>& binaries) {
+    indexes_ = binaries;
+    encodings_.resize(pool.size());
+    ages_.resize(pool.size());
+    for (std::size_t e = 0; e < pool.size(); ++e) {
+        encodings_[e].encode(pool.get_entries()[e].solution, indexes_);
+        ages_[e] = pool.get_entries()[e].age;
+    }
+}
+
+std::size_t orcs::NeighborhoodBatch::recombinations(const SolutionPool& pool,
+        const std::vector<std::size_t>& binaries, std::mt19937& random) {
+
+    pending_.clear();
+    if (pool.size() < 2) {
+        return 0;
+    }
+
+    encode(pool, binaries);
+    std::size_t num_words = encodings_.front().num_words();
+    std::uint64_t last_mask = last_word_mask(indexes_.size());
+
+    Neighborhood neighborhood;
+    for (std::size_t draw = 0; draw < MAX_DRAWS * capacity_ && pending_.size() < capacity_; ++draw) {
+
+        // Randomly select two solutions (the first one is the better one)
+        std::size_t idx2 = (random() % (pool.size() - 1)) + 1;
+        std::size_t idx1 = random() % idx2;
+        const std::uint64_t* a = encodings_[idx1].words();
+        const std::uint64_t* b = encodings_[idx2].words();
+
+        // Fix the variables on which they agree
+        neighborhood.fixed.reset(indexes_.size());
+        neighborhood.values.reset(indexes_.size());
+        std::uint64_t* fixed = neighborhood.fixed.words();
+        std::uint64_t* values = neighborhood.values.words();
+        for (std::size_t w = 0; w < num_words; ++w) {
+            fixed[w] = ~(a[w] ^ b[w]) & (w + 1 == num_words ? last_mask : ~std::uint64_t(0));
+            values[w] = a[w] & fixed[w];
+        }
+
+        neighborhood.seed_age = ages_[idx1];
+        keep(neighborhood);
+    }
+
+    std::reverse(pending_.begin(), pending_.end());
+    return pending_.size();
+}
+
+std::size_t orcs::NeighborhoodBatch::mutations(const SolutionPool& pool,
+        const std::vector<std::size_t>& binaries, double fixing_fraction, std::mt19937& random) {
+
+    pending_.clear();
+    if (pool.size() < 1) {
+        return 0;
+    }
+
+    encode(pool, binaries);
+    std::size_t num_words = (indexes_.size() + 63) / 64;
+    std::uint64_t last_mask = last_word_mask(indexes_.size());
+    unsigned long threshold = (unsigned long) std::round(
+            std::max(0.0, std::min(1.0, fixing_fraction)) * (1UL << PRECISION));
+
+    Neighborhood neighborhood;
+    for (std::size_t draw = 0; draw < MAX_DRAWS * capacity_ && pending_.size() < capacity_; ++draw) {
+
+        // Randomly select a seed solution
+        std::size_t idx = draw_seed(pool.size(), random);
+        const std::uint64_t* seed = encodings_[idx].words();
+
+        // Fix each variable with the given probability: the bits of the
+        // probability are consumed from the least significant one, and each
+        // step sets a bit with probability (bit + previous) / 2 by an OR (bit
+        // set) or an AND (bit not set) with a random word
+        neighborhood.fixed.reset(indexes_.size());
+        neighborhood.values.reset(indexes_.size());
+        std::uint64_t* fixed = neighborhood.fixed.words();
+        std::uint64_t* values = neighborhood.values.words();
+        for (std::size_t w = 0; w < num_words; ++w) {
+            std::uint64_t word = 0;
+            if (threshold >= (1UL << PRECISION)) {
+                word = ~std::uint64_t(0);
+            } else {
+                for (int b = 0; b < PRECISION; ++b) {
+                    word = (((threshold >> b) & 1) ? word | random_word(random) : word & random_word(random));
+                }
+            }
+
+            fixed[w] = word & (w + 1 == num_words ? last_mask : ~std::uint64_t(0));
+            values[w] = seed[w] & fixed[w];
+        }
+
+        neighborhood.seed_age = ages_[idx];
+        keep(neighborhood);
+    }
+
+    std::reverse(pending_.begin(), pending_.end());
+    return pending_.size();
+}
+
+bool orcs::NeighborhoodBatch::keep(Neighborhood& neighborhood) {
+
+    // Count the free variables and hash the neighborhood in one pass
+    std::size_t num_fixed = 0;
+    std::uint64_t hash = mix(neighborhood.fixed.size());
+    const std::uint64_t* fixed = neighborhood.fixed.words();
+    const std::uint64_t* values = neighborhood.values.words();
+    for (std::size_t w = 0; w < neighborhood.fixed.num_words(); ++w) {
+        num_fixed += __builtin_popcountll(fixed[w]);
+        hash = mix(hash ^ fixed[w]);
+        hash = mix(hash ^ values[w]);
+    }
+
+    neighborhood.num_free = neighborhood.fixed.size() - num_fixed;
+    neighborhood.hash = hash;
+
+    if (!generated_.insert(hash).second) {
+        return false;
+    }
+
+    pending_.push_back(neighborhood);
+    return true;
+}
+
+bool orcs::NeighborhoodBatch::pop(Neighborhood& neighborhood) {
+    if (pending_.empty()) {
+        return false;
+    }
+
+    neighborhood = std::move(pending_.back());
+    pending_.pop_back();
+    return true;
+}
+
+const std::vector<std::size_t>& orcs::NeighborhoodBatch::indexes() const {
+    return indexes_;
+}
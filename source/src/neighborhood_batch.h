@@ -0,0 +1,148 @@
+#ifndef ORCS_NEIGHBORHOOD_BATCH_H
+#define ORCS_NEIGHBORHOOD_BATCH_H
+
+#include "solution_pool.h"
+#include "bit_vector.h"
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <unordered_set>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class generates batches of fixing neighborhoods of Rothberg's
+ * heuristic as bitmasks over the binary variables. The entries of the pool
+ * are bit-packed once per batch, and each neighborhood is built by a few word
+ * operations: the variables fixed by a recombination are the ones on which a
+ * pair of solutions agree (NOT (a XOR b)), and the ones fixed by a mutation
+ * are sampled by random words. The number of free variables and a hash of
+ * each neighborhood are computed in the same pass, so neighborhoods already
+ * generated (since the last clear) are discarded without building their
+ * sub-MIPs.
+ */
+class NeighborhoodBatch {
+
+public:
+
+    /**
+     * A neighborhood: bit k of the masks refers to the binary variable
+     * indexes()[k].
+     */
+    struct Neighborhood {
+        BitVector fixed;
+        BitVector values;
+        unsigned long long seed_age;
+        std::size_t num_free;
+        std::uint64_t hash;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param   capacity
+     *          The number of neighborhoods generated by each batch.
+     */
+    explicit NeighborhoodBatch(std::size_t capacity);
+
+    /**
+     * Discard the pending neighborhoods and forget the ones generated so far.
+     */
+    void clear();
+
+    /**
+     * Generate a batch of recombination neighborhoods: each one fixes the
+     * binary variables on which a pair of solutions of the pool agree (the
+     * better one of the pair is the seed). Pairs are drawn as the ones of
+     * Rothberg's heuristic.
+     *
+     * @param   pool
+     *          The pool of solutions (with at least two entries).
+     * @param   binaries
+     *          The indexes of the binary variables (in the same order for all
+     *          batches since the last clear, since neighborhoods are
+     *          identified by their bits).
+     * @param   random
+     *          The random number generator.
+     *
+     * @return  The number of neighborhoods generated.
+     */
+    std::size_t recombinations(const SolutionPool& pool, const std::vector<std::size_t>& binaries,
+            std::mt19937& random);
+
+    /**
+     * Generate a batch of mutation neighborhoods: each one fixes each binary
+     * variable to its value in a seed solution with a given probability.
+     * Seeds are drawn as the ones of Rothberg's heuristic.
+     *
+     * @param   pool
+     *          The pool of solutions (with at least one entry).
+     * @param   binaries
+     *          The indexes of the binary variables (in the same order for all
+     *          batches since the last clear, since neighborhoods are
+     *          identified by their bits).
+     * @param   fixing_fraction
+     *          The probability of fixing each variable.
+     * @param   random
+     *          The random number generator.
+     *
+     * @return  The number of neighborhoods generated.
+     */
+    std::size_t mutations(const SolutionPool& pool, const std::vector<std::size_t>& binaries,
+            double fixing_fraction, std::mt19937& random);
+
+    /**
+     * Take the next pending neighborhood, if any.
+     *
+     * @param   neighborhood
+     *          Output: the neighborhood.
+     *
+     * @return  True if there was a pending neighborhood, false otherwise.
+     */
+    bool pop(Neighborhood& neighborhood);
+
+    /**
+     * Return the indexes of the binary variables the pending neighborhoods
+     * refer to.
+     *
+     * @return  The indexes of the binary variables.
+     */
+    const std::vector<std::size_t>& indexes() const;
+
+private:
+
+    /**
+     * Encode the entries of the pool (and keep the indexes of the variables).
+     */
+    void encode(const SolutionPool& pool, const std::vector<std::size_t>& binaries);
+
+    /**
+     * Complete a neighborhood (number of free variables and hash) and keep it,
+     * if it is new.
+     */
+    bool keep(Neighborhood& neighborhood);
+
+    /*
+     * Size of the batches, pending neighborhoods and hashes of the ones
+     * generated so far.
+     */
+    std::size_t capacity_;
+    std::vector<Neighborhood> pending_;
+    std::unordered_set<std::uint64_t> generated_;
+
+    /*
+     * Bit-packed entries of the pool (and their ages).
+     */
+    std::vector<std::size_t> indexes_;
+    std::vector<BitVector> encodings_;
+    std::vector<unsigned long long> ages_;
+};
+
+}
+
+#endif
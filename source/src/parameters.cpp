@@ -0,0 +1,91 @@
+#include "parameters.h"
+
+
+namespace {
+
+/*
+ * Throw an error message if a value is not between 0 and 1.
+ */
+void check_fraction(double value, const std::string& name) {
+    if (!(value >= 0.0 && value <= 1.0)) {
+        throw std::string("Invalid " + name + " (it must be a value between 0 and 1).");
+    }
+}
+
+/*
+ * Throw an error message if a value is negative.
+ */
+void check_non_negative(long value, const std::string& name) {
+    if (value < 0) {
+        throw std::string("Invalid " + name + " (it must be a non-negative value).");
+    }
+}
+
+}
+
+void orcs::SubmipParameters::validate() const {
+    check_non_negative(nodes_limit, "sub-MIP nodes limit");
+    check_non_negative(nodes_unsuccessful, "sub-MIP nodes without improvement");
+    check_non_negative(widening_steps, "sub-MIP widening steps");
+    check_fraction(widening_batch, "sub-MIP widening batch");
+    check_non_negative(component_min_size, "sub-MIP component minimum size");
+    check_non_negative(workers, "number of sub-MIP workers");
+    check_non_negative(backend_threshold, "sub-MIP backend threshold");
+    check_non_negative(recursion_depth, "sub-MIP recursion depth");
+    check_non_negative(recursion_min_size, "sub-MIP recursion minimum size");
+    check_non_negative(recursion_frequency, "sub-MIP recursion frequency");
+    if (backend != "cplex" && backend != "highs" && backend != "auto") {
+        throw std::string("Invalid sub-MIP backend.");
+    }
+}
+
+void orcs::PredictorParameters::validate() const {
+    check_fraction(threshold, "threshold of the success predictor");
+    check_non_negative(resamples, "number of resamples of the success predictor");
+    check_non_negative(warmup, "warmup of the success predictor");
+    check_fraction(exploration, "exploration of the success predictor");
+    if (!(learning_rate > 0.0)) {
+        throw std::string("Invalid learning rate of the success predictor (it must be a positive value).");
+    }
+}
+
+void orcs::HeuristicParameters::validate() const {
+    submip.validate();
+    predictor.validate();
+}
+
+void orcs::ConstructiveParameters::validate() const {
+    check_non_negative(attempts, "number of constructive attempts");
+    if (threads < 1) {
+        throw std::string("Invalid number of constructive threads (it must be a positive value).");
+    }
+    check_non_negative(candidates, "number of constructive candidates");
+    check_non_negative(repair_nodes, "constructive repair nodes limit");
+    if (time_limit < 0.0) {
+        throw std::string("Invalid constructive time limit (it must be a non-negative value).");
+    }
+}
+
+void orcs::MaravilhaParameters::validate() const {
+    check_non_negative(iterations, "number of iterations of Maravilha's heuristic");
+    check_fraction(submip_min, "minimum size of sub-MIPs of Maravilha's heuristic");
+    check_fraction(submip_max, "maximum size of sub-MIPs of Maravilha's heuristic");
+    check_fraction(offset, "offset of Maravilha's heuristic");
+    check_non_negative(relaxation_cache, "relaxation cache size of Maravilha's heuristic");
+    check_fraction(relaxation_diversity, "relaxation diversity of Maravilha's heuristic");
+    if (submip_min > submip_max) {
+        throw std::string("Invalid sizes of sub-MIPs of Maravilha's heuristic (minimum above maximum).");
+    }
+}
+
+void orcs::RothbergParameters::validate() const {
+    check_non_negative(recombinations, "number of recombinations of Rothberg's heuristic");
+    check_non_negative(mutations, "number of mutations of Rothberg's heuristic");
+    check_fraction(fixing_fraction, "fixing fraction of Rothberg's heuristic");
+    check_fraction(offset_init, "initial offset of Rothberg's heuristic");
+    check_fraction(offset_reduction, "offset reduction of Rothberg's heuristic");
+    check_fraction(offset_minimum, "minimum offset of Rothberg's heuristic");
+    if (batch < 1) {
+        throw std::string("Invalid batch size of Rothberg's heuristic (it must be a positive value).");
+    }
+}
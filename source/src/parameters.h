@@ -0,0 +1,221 @@
+#ifndef ORCS_PARAMETERS_H
+#define ORCS_PARAMETERS_H
+
+#include "abort_callback.h"
+#include "fixing_scores.h"
+#include "placement.h"
+#include <cstdlib>
+#include <string>
+#include <limits>
+
+
+namespace orcs {
+
+/**
+ * Parameters of the sub-MIPs solved by the heuristics. Parameters are typed
+ * and validated once (when loaded), then the same structure can be shared by
+ * any number of heuristics and workers.
+ */
+struct SubmipParameters {
+
+    /*
+     * Seed of the random number generators.
+     */
+    int seed = 0;
+
+    /*
+     * Stopping criteria of each sub-MIP (nodes explored, nodes explored
+     * without improvement and stall of the relative gap).
+     */
+    long nodes_limit = 500;
+    long nodes_unsuccessful = std::numeric_limits<long>::max();
+    StallCriterion stall;
+
+    /*
+     * Margin of improvement over the incumbent solution that makes a sub-MIP
+     * exit early (negative values disable it).
+     */
+    double early_exit = -1.0;
+
+    /*
+     * Whether solutions of the pool are given to sub-MIPs as MIP starts.
+     */
+    bool pool_starts = false;
+
+    /*
+     * Widening of sub-MIPs solved to optimality without improvement.
+     */
+    long widening_steps = 0;
+    double widening_batch = 0.05;
+
+    /*
+     * Splitting of sub-MIPs into independent components and the workers
+     * (threads, backends and their placement) that solve them.
+     */
+    bool split_components = false;
+    long component_min_size = 50;
+    long workers = 0;
+    std::string backend = "cplex";
+    long backend_threshold = 1000;
+    Placement::Policy placement = Placement::Policy::NONE;
+
+    /*
+     * Whether the continuous part of the solutions of sub-MIPs not solved to
+     * optimality is polished by an LP (in mixed problems).
+     */
+    bool lp_polishing = false;
+
+    /*
+     * Recursive polishing: sub-MIPs with at least a minimum number of free
+     * variables host a nested heuristic (of the same kind), called every given
+     * number of nodes, down to a maximum depth (zero disables it).
+     */
+    long recursion_depth = 0;
+    long recursion_min_size = 1000;
+    long recursion_frequency = 50;
+
+    /**
+     * Check whether the parameters are valid. It throws an error message
+     * (std::string) if a parameter is not valid.
+     */
+    void validate() const;
+};
+
+/**
+ * Parameters of the online predictor of the success of neighborhoods, which
+ * resamples the neighborhoods unlikely to succeed before solving them.
+ */
+struct PredictorParameters {
+
+    /*
+     * Minimum predicted probability of success of a neighborhood to be solved
+     * (zero disables the predictor) and maximum number of neighborhoods
+     * resampled in a row (the last one is solved anyway).
+     */
+    double threshold = 0.0;
+    long resamples = 3;
+
+    /*
+     * Learning rate of the model, number of neighborhoods solved before the
+     * predictor starts to resample and probability of solving a neighborhood
+     * regardless of its prediction (to keep learning about all of them).
+     */
+    double learning_rate = 0.05;
+    long warmup = 20;
+    double exploration = 0.1;
+
+    /**
+     * Check whether the parameters are valid. It throws an error message
+     * (std::string) if a parameter is not valid.
+     */
+    void validate() const;
+};
+
+/**
+ * Parameters shared by the MIP heuristics.
+ */
+struct HeuristicParameters {
+
+    /*
+     * How the binary variables to fix and to keep free are chosen.
+     */
+    FixingScores::Strategy fixing_strategy = FixingScores::Strategy::RANDOM;
+    bool connected_sampling = false;
+
+    /*
+     * Parameters of the sub-MIPs and of the predictor of their success.
+     */
+    SubmipParameters submip;
+    PredictorParameters predictor;
+
+    /**
+     * Check whether the parameters are valid. It throws an error message
+     * (std::string) if a parameter is not valid.
+     */
+    void validate() const;
+};
+
+/**
+ * Parameters of the fix-and-propagate constructive heuristic, which seeds the
+ * pool before the first phase.
+ */
+struct ConstructiveParameters {
+
+    /**
+     * Orders in which the integer variables are fixed. RANDOM fixes them in a
+     * random order to the bound preferred by the objective function.
+     * RELAXATION fixes the most integral ones (in the LP relaxation) first, to
+     * their rounded (randomly, but in the first attempt) relaxed values.
+     */
+    enum class Order { RANDOM, RELAXATION };
+
+    /*
+     * Number of attempts (zero disables the heuristic) and threads that run
+     * them.
+     */
+    long attempts = 0;
+    long threads = 1;
+    Order order = Order::RANDOM;
+
+    /*
+     * Number of attempts kept (the ones with fewest conflicts), which are
+     * completed or repaired by a sub-MIP, and stopping criteria of the repair
+     * sub-MIPs and of the whole heuristic.
+     */
+    long candidates = 10;
+    long repair_nodes = 500;
+    double time_limit = 10.0;
+
+    int seed = 0;
+    Placement::Policy placement = Placement::Policy::NONE;
+
+    /**
+     * Check whether the parameters are valid. It throws an error message
+     * (std::string) if a parameter is not valid.
+     */
+    void validate() const;
+};
+
+/**
+ * Parameters of Maravilha's MIP heuristic.
+ */
+struct MaravilhaParameters {
+
+    long iterations = 1;
+    double submip_min = 0.00;
+    double submip_max = 0.65;
+    double offset = 0.45;
+    long relaxation_cache = 0;
+    double relaxation_diversity = 0.05;
+
+    /**
+     * Check whether the parameters are valid. It throws an error message
+     * (std::string) if a parameter is not valid.
+     */
+    void validate() const;
+};
+
+/**
+ * Parameters of Rothberg's MIP heuristic.
+ */
+struct RothbergParameters {
+
+    long recombinations = 40;
+    long mutations = 20;
+    double fixing_fraction = 0.5;
+    double offset_init = 0.2;
+    double offset_reduction = 0.25;
+    double offset_minimum = 0.01;
+    bool local_branching = false;
+    long batch = 1;
+
+    /**
+     * Check whether the parameters are valid. It throws an error message
+     * (std::string) if a parameter is not valid.
+     */
+    void validate() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+#include "placement.h"
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace {
+
+/*
+ * Whether huge pages are enabled.
+ */
+std::atomic<bool> huge_pages_enabled(false);
+
+/*
+ * Parse a list of cores in the format used by Linux (e.g., "0-3,8-11").
+ */
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+
+        std::size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = (dash == std::string::npos ? first : std::stoi(range.substr(dash + 1)));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+}
+
+
+orcs::Placement::Policy orcs::Placement::parse_policy(const std::string& name) {
+    if (name == "compact") {
+        return Policy::COMPACT;
+    } else if (name == "scatter") {
+        return Policy::SCATTER;
+    }
+
+    return Policy::NONE;
+}
+
+orcs::Placement::Placement(Policy policy) : policy_(policy) {
+
+    if (policy_ == Policy::NONE) {
+        return;
+    }
+
+#ifdef __linux__
+
+    // Cores the process is allowed to run on
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        policy_ = Policy::NONE;
+        return;
+    }
+
+    // Cores of each NUMA node
+    for (int node = 0; ; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) {
+            break;
+        }
+
+        std::string list;
+        std::getline(file, list);
+
+        std::vector<int> cpus;
+        for (auto cpu : parse_cpu_list(list)) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        if (!cpus.empty()) {
+            node_cpus_.push_back(cpus);
+        }
+    }
+
+    // Without NUMA information, all cores are regarded as a single node
+    if (node_cpus_.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        node_cpus_.push_back(cpus);
+    }
+
+    // Placement order
+    if (policy_ == Policy::COMPACT) {
+        for (std::size_t node = 0; node < node_cpus_.size(); ++node) {
+            for (auto cpu : node_cpus_[node]) {
+                slot_cpus_.push_back(cpu);
+                slot_nodes_.push_back(static_cast<int>(node));
+            }
+        }
+    } else {
+        std::size_t max_cpus = 0;
+        for (const auto& cpus : node_cpus_) {
+            max_cpus = std::max(max_cpus, cpus.size());
+        }
+
+        for (std::size_t k = 0; k < max_cpus; ++k) {
+            for (std::size_t node = 0; node < node_cpus_.size(); ++node) {
+                if (k < node_cpus_[node].size()) {
+                    slot_cpus_.push_back(node_cpus_[node][k]);
+                    slot_nodes_.push_back(static_cast<int>(node));
+                }
+            }
+        }
+    }
+
+    if (slot_cpus_.empty()) {
+        policy_ = Policy::NONE;
+    }
+
+#else
+
+    policy_ = Policy::NONE;
+
+#endif
+}
+
+std::size_t orcs::Placement::num_nodes() const {
+    return std::max<std::size_t>(node_cpus_.size(), 1);
+}
+
+int orcs::Placement::pin_main() const {
+    return pin(0);
+}
+
+int orcs::Placement::pin_main_node() const {
+
+    if (policy_ == Policy::NONE) {
+        return -1;
+    }
+
+#ifdef __linux__
+
+    int node = slot_nodes_[0];
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (auto cpu : node_cpus_[node]) {
+        CPU_SET(cpu, &cpus);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        return -1;
+    }
+
+    return node;
+
+#else
+
+    return -1;
+
+#endif
+}
+
+int orcs::Placement::pin_worker(std::size_t worker) const {
+    return pin(worker + 1);
+}
+
+void orcs::Placement::set_huge_pages(bool enabled) {
+    huge_pages_enabled = enabled;
+}
+
+bool orcs::Placement::huge_pages() {
+    return huge_pages_enabled;
+}
+
+int orcs::Placement::pin(std::size_t slot) const {
+
+    if (policy_ == Policy::NONE) {
+        return -1;
+    }
+
+#ifdef __linux__
+
+    slot = slot % slot_cpus_.size();
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(slot_cpus_[slot], &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        return -1;
+    }
+
+    return slot_nodes_[slot];
+
+#else
+
+    return -1;
+
+#endif
+}
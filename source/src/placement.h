@@ -0,0 +1,186 @@
+#ifndef ORCS_PLACEMENT_H
+#define ORCS_PLACEMENT_H
+
+#include <cstdlib>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+
+namespace orcs {
+
+/**
+ * This class places threads on the cores of the machine. The cores are grouped
+ * by NUMA node (as reported by the operating system) and ordered by a policy:
+ * COMPACT fills the cores of a node before moving to the next one, while
+ * SCATTER alternates among the nodes. The main search takes the first core of
+ * this order and each worker takes the next ones. Since memory is allocated on
+ * the node of the thread that first touches it, data built by a pinned thread
+ * (e.g., the copy of the problem kept by a worker) is local to its node.
+ */
+class Placement {
+
+public:
+
+    /**
+     * Placement policies.
+     */
+    enum class Policy { NONE, COMPACT, SCATTER };
+
+    /**
+     * Return the placement policy with a given name.
+     *
+     * @param   name
+     *          The name of the policy (none, compact or scatter).
+     *
+     * @return  The placement policy.
+     */
+    static Policy parse_policy(const std::string& name);
+
+    /**
+     * Constructor. It reads the NUMA topology of the machine, restricted to
+     * the cores the process is allowed to run on.
+     *
+     * @param   policy
+     *          The placement policy.
+     */
+    explicit Placement(Policy policy);
+
+    /**
+     * Return the number of NUMA nodes.
+     *
+     * @return  The number of NUMA nodes.
+     */
+    std::size_t num_nodes() const;
+
+    /**
+     * Pin the calling thread to the core of the main search.
+     *
+     * @return  The NUMA node of the core (or -1 if the thread was not pinned).
+     */
+    int pin_main() const;
+
+    /**
+     * Pin the calling thread to the cores of the NUMA node of the main search
+     * (e.g., a thread that builds data used later by the main search, without
+     * taking the core of the main search).
+     *
+     * @return  The NUMA node (or -1 if the thread was not pinned).
+     */
+    int pin_main_node() const;
+
+    /**
+     * Pin the calling thread to the core of a worker. If there are more
+     * threads than cores, cores are shared in a round-robin fashion.
+     *
+     * @param   worker
+     *          The index of the worker.
+     *
+     * @return  The NUMA node of the core (or -1 if the thread was not pinned).
+     */
+    int pin_worker(std::size_t worker) const;
+
+    /**
+     * Enable or disable (transparent) huge pages for large arrays allocated by
+     * HugePageAllocator.
+     *
+     * @param   enabled
+     *          True to enable huge pages, false otherwise.
+     */
+    static void set_huge_pages(bool enabled);
+
+    /**
+     * Return whether huge pages are enabled.
+     *
+     * @return  True if huge pages are enabled, false otherwise.
+     */
+    static bool huge_pages();
+
+private:
+
+    /**
+     * Pin the calling thread to the core of a slot of the placement order.
+     */
+    int pin(std::size_t slot) const;
+
+    Policy policy_;
+
+    /*
+     * Cores of each NUMA node.
+     */
+    std::vector<std::vector<int>> node_cpus_;
+
+    /*
+     * Placement order (core and NUMA node of each slot).
+     */
+    std::vector<int> slot_cpus_;
+    std::vector<int> slot_nodes_;
+};
+
+/**
+ * An allocator that backs large arrays with transparent huge pages (if they
+ * are enabled by Placement::set_huge_pages), which reduces TLB misses when
+ * large arrays are traversed. Small arrays are allocated as usual.
+ */
+template<class T>
+struct HugePageAllocator {
+
+    using value_type = T;
+
+    /*
+     * Size of a huge page (arrays smaller than it are allocated as usual).
+     */
+    static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    HugePageAllocator() = default;
+
+    template<class U>
+    HugePageAllocator(const HugePageAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        std::size_t bytes = n * sizeof(T);
+        void* ptr = nullptr;
+
+#ifdef __linux__
+        if (bytes >= HUGE_PAGE_SIZE && Placement::huge_pages()) {
+            bytes = ((bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+            ptr = std::aligned_alloc(HUGE_PAGE_SIZE, bytes);
+            if (ptr != nullptr) {
+                madvise(ptr, bytes, MADV_HUGEPAGE);
+            }
+        } else {
+            ptr = std::malloc(bytes);
+        }
+#else
+        ptr = std::malloc(bytes);
+#endif
+
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t) {
+        std::free(ptr);
+    }
+};
+
+template<class T, class U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) {
+    return true;
+}
+
+template<class T, class U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) {
+    return false;
+}
+
+}
+
+#endif
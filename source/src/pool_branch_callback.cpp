@@ -0,0 +1,109 @@
+#include "pool_branch_callback.h"
+#include <cmath>
+#include <algorithm>
+
+
+IloCplex::Callback orcs::PoolBranchCallback::create_instance(IloEnv& env, 
+        const orcs::SolutionPool* pool, IloNumVarArray& variables, long frequency,
+        double min_agreement) {
+    return (IloCplex::Callback(new (env) orcs::PoolBranchCallback(env, pool, variables,
+            frequency, min_agreement)));
+}
+
+orcs::PoolBranchCallback::PoolBranchCallback(IloEnv& env, const orcs::SolutionPool* pool, 
+        IloNumVarArray& variables, long frequency, double min_agreement) :
+    IloCplex::BranchCallbackI(env), pool_(pool), variables_(variables),
+    frequency_(frequency), min_agreement_(min_agreement), last_update_(-1)
+{
+    // Identify binary variables
+    for (std::size_t i = 0; i < (std::size_t) variables_.getSize(); ++i) {
+        if (variables_[i].getType() == IloNumVar::Type::Bool || 
+                (variables_[i].getType() == IloNumVar::Type::Int && 
+                std::abs(variables_[i].getLB()) < THRESHOLD && 
+                std::abs(variables_[i].getUB() - 1.0) < THRESHOLD)) {
+            binary_variables_.push_back(i);
+        }
+    }
+}
+
+IloCplex::CallbackI* orcs::PoolBranchCallback::duplicateCallback() const {
+    return (new (getEnv()) orcs::PoolBranchCallback(*this));
+}
+
+void orcs::PoolBranchCallback::main() {
+
+    // Keep CPLEX decision when it would not branch
+    if (getNbranches() == 0) {
+        return;
+    }
+
+    // Update the agreement of the pool periodically
+    IloInt64 nnodes = getNnodes64();
+    if (last_update_ < 0 || nnodes - last_update_ >= frequency_) {
+        update();
+        last_update_ = nnodes;
+    }
+
+    // Branch on the fractional variable with the greatest agreement
+    std::size_t num_candidates = std::min(candidates_.size(), MAX_CANDIDATES);
+    for (std::size_t k = 0; k < num_candidates; ++k) {
+        const IloNumVar& variable = variables_[candidates_[k]];
+        IloNum value = getValue(variable);
+        if (value > THRESHOLD && value < 1.0 - THRESHOLD) {
+
+            // The child preferred by the pool is created first
+            IloNum estimate = getObjValue();
+            if (preferred_[k] > 0.5) {
+                makeBranch(variable, 1.0, IloCplex::BranchUp, estimate);
+                makeBranch(variable, 0.0, IloCplex::BranchDown, estimate);
+            } else {
+                makeBranch(variable, 0.0, IloCplex::BranchDown, estimate);
+                makeBranch(variable, 1.0, IloCplex::BranchUp, estimate);
+            }
+
+            return;
+        }
+    }
+}
+
+void orcs::PoolBranchCallback::update() {
+
+    candidates_.clear();
+    preferred_.clear();
+
+    // The agreement of a single solution is meaningless
+    const std::vector<SolutionPool::Entry>& entries = pool_->get_entries();
+    if (entries.size() < 2) {
+        return;
+    }
+
+    // Agreement of the pool on each binary variable (and its preferred value)
+    struct Candidate {
+        double agreement;
+        std::size_t idx;
+        IloNum preferred;
+    };
+
+    std::vector<Candidate> candidates;
+    for (auto idx : binary_variables_) {
+        std::size_t ones = 0;
+        for (const auto& entry : entries) {
+            ones += (entry.solution[idx] > 0.5 ? 1 : 0);
+        }
+
+        double proportion = ones / (double) entries.size();
+        double agreement = std::abs(2.0 * proportion - 1.0);
+        if (agreement >= min_agreement_) {
+            candidates.push_back({agreement, idx, (proportion > 0.5 ? 1.0 : 0.0)});
+        }
+    }
+
+    // Sort the candidates by decreasing agreement
+    std::stable_sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.agreement > b.agreement; });
+
+    for (const auto& candidate : candidates) {
+        candidates_.push_back(candidate.idx);
+        preferred_.push_back(candidate.preferred);
+    }
+}
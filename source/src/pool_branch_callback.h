@@ -0,0 +1,109 @@
+#ifndef ORCS_POOL_BRANCH_CALLBACK_H
+#define ORCS_POOL_BRANCH_CALLBACK_H
+
+
+#include "solution_pool.h"
+#include <cstdlib>
+#include <vector>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+
+/**
+ * Callback class used to guide the branching of the optimization process by
+ * the solutions in the pool. The agreement of the pool on each binary variable
+ * (i.e., how many solutions assign the same value to it) is periodically
+ * computed. At each node, the callback branches on the fractional binary
+ * variable with the greatest agreement (if it is at least a minimum one), and
+ * the child in which the variable takes the value preferred by the pool is
+ * created first, so that the search dives toward the region indicated by the
+ * pool. Otherwise, the branching chosen by CPLEX is kept.
+ */
+class PoolBranchCallback : public IloCplex::BranchCallbackI {
+
+public:
+    
+    /**
+     * This static method creates a new instance of this class and returns a 
+     * handle for the instance.
+     * 
+     * @param   env
+     *          CPLEX environment.
+     * @param   pool
+     *          The solution pool.
+     * @param   variables
+     *          Variables of the optimization problem.
+     * @param   frequency
+     *          Number of nodes between updates of the agreement of the pool.
+     * @param   min_agreement
+     *          The minimum agreement (between 0 and 1) of the pool on a 
+     *          variable to branch on it, where 0 means that half of the 
+     *          solutions assign each value to the variable and 1 means that
+     *          all solutions assign the same value to it.
+     */
+    static IloCplex::Callback create_instance(IloEnv& env, const SolutionPool* pool, 
+            IloNumVarArray& variables, long frequency, double min_agreement);
+
+protected:
+    
+    /**
+     * Constructor is made protected. For creating an instance, you should call
+     * the static method create_instance(...).
+     * 
+     * @param   env
+     *          CPLEX environment.
+     * @param   pool
+     *          The solution pool.
+     * @param   variables
+     *          Variables of the optimization problem.
+     * @param   frequency
+     *          Number of nodes between updates of the agreement of the pool.
+     * @param   min_agreement
+     *          The minimum agreement of the pool on a variable to branch on it.
+     */
+    PoolBranchCallback(IloEnv& env, const SolutionPool* pool, IloNumVarArray& variables,
+            long frequency, double min_agreement);
+    
+    IloCplex::CallbackI* duplicateCallback() const override;
+
+    void main() override;
+    
+private:
+
+    /**
+     * Compute the agreement of the pool on each binary variable and sort the
+     * candidates to branch on.
+     */
+    void update();
+    
+    const SolutionPool* pool_;
+    IloNumVarArray variables_;
+    long frequency_;
+    double min_agreement_;
+
+    /*
+     * Binary variables, the candidates to branch on (sorted by decreasing 
+     * agreement) and the value preferred by the pool for each candidate.
+     */
+    std::vector<std::size_t> binary_variables_;
+    std::vector<std::size_t> candidates_;
+    std::vector<IloNum> preferred_;
+    IloInt64 last_update_;
+
+    static constexpr double THRESHOLD = 1e-5;
+
+    /*
+     * Maximum number of candidates checked at each node.
+     */
+    static constexpr std::size_t MAX_CANDIDATES = 100;
+    
+};
+
+}
+
+
+#endif
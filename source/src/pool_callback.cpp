@@ -2,13 +2,14 @@
 
 
 IloCplex::Callback orcs::PoolCallback::create_instance(IloEnv& env, 
-        orcs::SolutionPool* pool, IloNumVarArray& variables) {
-    return (IloCplex::Callback(new (env) orcs::PoolCallback(env, pool, variables)));
+        orcs::SolutionPool* pool, IloNumVarArray& variables, IncumbentBroadcast* broadcast) {
+    return (IloCplex::Callback(new (env) orcs::PoolCallback(env, pool, variables, broadcast)));
 }
 
 orcs::PoolCallback::PoolCallback(IloEnv& env, orcs::SolutionPool* pool, 
-        IloNumVarArray& variables) :
-    IloCplex::IncumbentCallbackI(env), pool_(pool), variables_(variables)
+        IloNumVarArray& variables, IncumbentBroadcast* broadcast) :
+    IloCplex::IncumbentCallbackI(env), pool_(pool), variables_(variables),
+    broadcast_(broadcast)
 {
     // It does nothing here.
 }
@@ -26,6 +27,11 @@ void orcs::PoolCallback::main() {
     
     // Try to add the new entry into the solution pool
     pool_->add_entry(solution, value);
+
+    // Publish its value to the sub-MIPs in flight
+    if (broadcast_ != nullptr) {
+        broadcast_->publish(value);
+    }
     
     // Free resources
     solution.end();
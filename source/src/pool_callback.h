@@ -3,6 +3,7 @@
 
 
 #include "solution_pool.h"
+#include "incumbent_broadcast.h"
 #include <ilcplex/ilocplex.h>
 
 ILOSTLBEGIN
@@ -29,9 +30,12 @@ public:
      *          A solution pool to keep the solutions found.
      * @param   variables
      *          Variables of the optimization problem.
+     * @param   broadcast
+     *          The global incumbent, into which the solutions found are
+     *          published (or nullptr, to disable it).
      */
     static IloCplex::Callback create_instance(IloEnv& env, SolutionPool* pool, 
-            IloNumVarArray& variables);
+            IloNumVarArray& variables, IncumbentBroadcast* broadcast = nullptr);
 
 protected:
     
@@ -45,8 +49,12 @@ protected:
      *          A solution pool to keep the solutions found.
      * @param   variables
      *          Variables of the optimization problem.
+     * @param   broadcast
+     *          The global incumbent, into which the solutions found are
+     *          published (or nullptr, to disable it).
      */
-    PoolCallback(IloEnv& env, SolutionPool* pool, IloNumVarArray& variables);
+    PoolCallback(IloEnv& env, SolutionPool* pool, IloNumVarArray& variables,
+            IncumbentBroadcast* broadcast);
     
     IloCplex::CallbackI* duplicateCallback() const override;
 
@@ -56,6 +64,7 @@ private:
     
     SolutionPool* pool_;
     IloNumVarArray variables_;
+    IncumbentBroadcast* broadcast_;
     
 };
 
@@ -0,0 +1,141 @@
+#include "pool_file.h"
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+
+namespace {
+
+/*
+ * Identification of the file format.
+ */
+const std::string MAGIC = "ORCS-POOL";
+constexpr int VERSION = 1;
+
+/*
+ * Name of a variable (a default one for variables without names).
+ */
+std::string name_of(const IloNumVar& variable, std::size_t index) {
+    const char* name = variable.getName();
+    return (name != nullptr && name[0] != '\0' ? std::string(name) : "x" + std::to_string(index + 1));
+}
+
+}
+
+void orcs::PoolFile::write(const std::string& filename, const SolutionPool& pool,
+        const IloNumVarArray& variables) {
+
+    std::ofstream file(filename);
+    if (!file) {
+        throw std::string("Invalid pool file (it cannot be written).");
+    }
+
+    file.precision(17);
+    file << MAGIC << " " << VERSION << "\n";
+
+    std::size_t n = variables.getSize();
+    file << "variables " << n << "\n";
+    for (std::size_t j = 0; j < n; ++j) {
+        file << name_of(variables[j], j) << "\n";
+    }
+
+    file << "solutions " << pool.get_entries().size() << "\n";
+    for (const auto& entry : pool.get_entries()) {
+        std::size_t nonzeros = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            nonzeros += (entry.solution[j] != 0.0 ? 1 : 0);
+        }
+
+        file << entry.value << " " << nonzeros << "\n";
+        for (std::size_t j = 0; j < n; ++j) {
+            if (entry.solution[j] != 0.0) {
+                file << j << " " << entry.solution[j] << "\n";
+            }
+        }
+    }
+
+    if (!file.flush()) {
+        throw std::string("Invalid pool file (it cannot be written).");
+    }
+}
+
+orcs::PoolFile::PoolFile(const std::string& filename) {
+
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::string("Invalid pool file (it cannot be read).");
+    }
+
+    std::string magic, keyword;
+    int version;
+    if (!(file >> magic >> version) || magic != MAGIC || version != VERSION) {
+        throw std::string("Invalid pool file (unknown format).");
+    }
+
+    std::size_t n;
+    if (!(file >> keyword >> n) || keyword != "variables") {
+        throw std::string("Invalid pool file (missing variables).");
+    }
+
+    for (std::size_t j = 0; j < n; ++j) {
+        std::string name;
+        if (!(file >> name) || !indices_.emplace(name, j).second) {
+            throw std::string("Invalid pool file (missing or duplicated variable names).");
+        }
+    }
+
+    std::size_t num_solutions;
+    if (!(file >> keyword >> num_solutions) || keyword != "solutions") {
+        throw std::string("Invalid pool file (missing solutions).");
+    }
+
+    solutions_.resize(num_solutions);
+    for (auto& solution : solutions_) {
+        double objective;
+        std::size_t nonzeros;
+        if (!(file >> objective >> nonzeros) || nonzeros > n) {
+            throw std::string("Invalid pool file (truncated solution).");
+        }
+
+        solution.reserve(nonzeros);
+        for (std::size_t k = 0; k < nonzeros; ++k) {
+            std::size_t j;
+            double value;
+            if (!(file >> j >> value) || j >= n || !std::isfinite(value)) {
+                throw std::string("Invalid pool file (truncated solution).");
+            }
+            solution.emplace_back(j, value);
+        }
+    }
+}
+
+std::size_t orcs::PoolFile::size() const {
+    return solutions_.size();
+}
+
+std::vector<double> orcs::PoolFile::map(std::size_t index, const IloNumVarArray& variables,
+        std::size_t& num_mapped) const {
+
+    // Values of the solution by the index of the variable in the file
+    std::vector<double> stored(indices_.size(), 0.0);
+    for (const auto& nonzero : solutions_[index]) {
+        stored[nonzero.first] = nonzero.second;
+    }
+
+    // Map them onto the variables of the problem by their names
+    std::size_t n = variables.getSize();
+    std::vector<double> values(n, std::numeric_limits<double>::quiet_NaN());
+    num_mapped = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+        auto it = indices_.find(name_of(variables[j], j));
+        if (it != indices_.end()) {
+            double lb = variables[j].getLB();
+            double ub = variables[j].getUB();
+            values[j] = std::max(lb, std::min(ub, stored[it->second]));
+            ++num_mapped;
+        }
+    }
+
+    return values;
+}
@@ -0,0 +1,103 @@
+#ifndef ORCS_POOL_FILE_H
+#define ORCS_POOL_FILE_H
+
+#include "solution_pool.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class reads a pool of solutions exported by a previous run, which can
+ * warm start the optimization of a modified version of the problem (e.g., the
+ * next instance of a recurring problem). Solutions are stored by the names of
+ * the variables, so they can be mapped onto a problem whose variables were
+ * added, removed or reordered. The file is a text file:
+ *
+ *     ORCS-POOL 1
+ *     variables 3
+ *     x1
+ *     x2
+ *     y
+ *     solutions 2
+ *     12.5 2              # value of the objective, number of nonzero values
+ *     0 1                 # index of the variable, value
+ *     2 3.5
+ *     14 1
+ *     1 1
+ *
+ * Variables missing from a solution have value zero.
+ */
+class PoolFile {
+
+public:
+
+    /**
+     * Write the entries of a pool of solutions into a file. It throws an
+     * error message (std::string) if the file can not be written.
+     *
+     * @param   filename
+     *          Path to the file.
+     * @param   pool
+     *          The pool of solutions.
+     * @param   variables
+     *          The variables of the problem (their names identify them).
+     */
+    static void write(const std::string& filename, const SolutionPool& pool,
+            const IloNumVarArray& variables);
+
+    /**
+     * Constructor. It reads a pool of solutions from a file. It throws an
+     * error message (std::string) if the file can not be read or is not valid.
+     *
+     * @param   filename
+     *          Path to the file.
+     */
+    explicit PoolFile(const std::string& filename);
+
+    /**
+     * Return the number of solutions in the file.
+     *
+     * @return  The number of solutions.
+     */
+    std::size_t size() const;
+
+    /**
+     * Map a solution onto the variables of a problem by their names. Values
+     * are clamped to the bounds of the variables, and variables unknown to
+     * the file have value NaN.
+     *
+     * @param   index
+     *          The index of the solution.
+     * @param   variables
+     *          The variables of the problem.
+     * @param   num_mapped
+     *          Output: the number of variables known to the file.
+     *
+     * @return  The values of the variables.
+     */
+    std::vector<double> map(std::size_t index, const IloNumVarArray& variables,
+            std::size_t& num_mapped) const;
+
+private:
+
+    /*
+     * Index of each variable by its name.
+     */
+    std::unordered_map<std::string, std::size_t> indices_;
+
+    /*
+     * Nonzero values (index of the variable and value) of each solution.
+     */
+    std::vector<std::vector<std::pair<std::size_t, double>>> solutions_;
+};
+
+}
+
+#endif
@@ -3,14 +3,31 @@
 
 orcs::ProblemData::ProblemData(IloEnv& env_, const std::string& filename_) : 
     env(env_), filename(filename_), cplex(env), model(env), objective(), 
-    variables(env), constraints(env)
+    variables(env), constraints(env), owns_env_(false)
 {
-    
-    // Import model from file
-    cplex.importModel(model, filename.c_str(), objective, variables, constraints);
-    cplex.extract(model);
+    load();
+}
+
+orcs::ProblemData::ProblemData(const std::string& filename_) :
+    filename(filename_), env(), cplex(env), model(env), objective(),
+    variables(env), constraints(env), owns_env_(true)
+{
+    env.setOut(env.getNullStream());
+    env.setWarning(env.getNullStream());
+    env.setError(env.getNullStream());
+    load();
 }
 
 orcs::ProblemData::~ProblemData() {
     cplex.end();
+    if (owns_env_) {
+        env.end();
+    }
+}
+
+void orcs::ProblemData::load() {
+    
+    // Import model from file
+    cplex.importModel(model, filename.c_str(), objective, variables, constraints);
+    cplex.extract(model);
 }
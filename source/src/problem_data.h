@@ -37,6 +37,17 @@ public:
      *          A countdown.
      */
     ProblemData(IloEnv& env, const std::string& filename);
+
+    /**
+     * Constructor. This constructor loads an optimization problem from a file
+     * into its own CPLEX environment (with output disabled), which is ended
+     * with the object. Since CPLEX environments are not thread safe, it allows
+     * the problem to be loaded and used by another thread.
+     * 
+     * @param   filename
+     *          Path to file containing the optimization problem to be loaded.
+     */
+    explicit ProblemData(const std::string& filename);
     
     /**
      * Destructor.
@@ -48,6 +59,18 @@ public:
     ProblemData& operator=(const ProblemData& other) = delete;
     ProblemData& operator=(ProblemData&& other) = delete;
 
+private:
+
+    /**
+     * Import the model from the file.
+     */
+    void load();
+
+    /*
+     * Whether the CPLEX environment is owned by this object.
+     */
+    bool owns_env_;
+
 };
 
 }
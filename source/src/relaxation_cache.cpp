@@ -0,0 +1,103 @@
+#include "relaxation_cache.h"
+#include <cmath>
+#include <algorithm>
+
+
+orcs::RelaxationCache::RelaxationCache(std::size_t capacity, double min_diversity) :
+        capacity_(capacity), min_diversity_(min_diversity), size_(0)
+{
+    objectives_.resize(capacity_);
+    nearest_.resize(capacity_);
+    distances_.resize(capacity_);
+}
+
+bool orcs::RelaxationCache::offer(const IloNumArray& relaxation, double objective,
+        const IloNumArray& incumbent, const std::vector<std::size_t>& binary_variables) {
+
+    std::size_t nb = binary_variables.size();
+    if (capacity_ == 0 || nb == 0) {
+        return false;
+    }
+
+    // Allocate the storage on the first call
+    if (candidate_.size() != nb) {
+        values_.resize(capacity_ * nb);
+        candidate_.resize(nb);
+    }
+
+    // Quantize the relaxation and compute its distance to the incumbent
+    double diversity = 0.0;
+    for (std::size_t k = 0; k < nb; ++k) {
+        double value = std::max(0.0, std::min(1.0, (double) relaxation[binary_variables[k]]));
+        candidate_[k] = (std::uint8_t) std::lround(value * LEVELS);
+        diversity += std::abs(candidate_[k] / LEVELS - (incumbent[binary_variables[k]] > 0.5 ? 1.0 : 0.0));
+    }
+    diversity /= nb;
+
+    // Distance to the relaxations in the cache
+    for (std::size_t e = 0; e < size_; ++e) {
+        distances_[e] = distance(e);
+        diversity = std::min(diversity, distances_[e]);
+    }
+
+    if (diversity < min_diversity_) {
+        return false;
+    }
+
+    // Choose the position of the new relaxation
+    std::size_t position = size_;
+    if (size_ == capacity_) {
+        position = (std::size_t) (std::min_element(nearest_.begin(), nearest_.end()) - nearest_.begin());
+        if (nearest_[position] >= diversity) {
+            return false;
+        }
+    } else {
+        ++size_;
+    }
+
+    // Distances of other relaxations to their nearest ones (the new one may be
+    // closer; distances to the replaced one are kept as an approximation)
+    for (std::size_t e = 0; e < size_; ++e) {
+        if (e != position) {
+            nearest_[e] = std::min(nearest_[e], distances_[e]);
+        }
+    }
+
+    // Store the new relaxation
+    std::copy(candidate_.begin(), candidate_.end(), values_.begin() + position * nb);
+    objectives_[position] = objective;
+    nearest_[position] = diversity;
+
+    return true;
+}
+
+double orcs::RelaxationCache::sample(std::mt19937& rng, IloNumArray& guide,
+        const std::vector<std::size_t>& binary_variables) const {
+
+    std::size_t nb = binary_variables.size();
+    std::size_t entry = rng() % size_;
+
+    const std::uint8_t* values = values_.data() + entry * nb;
+    for (std::size_t k = 0; k < nb; ++k) {
+        guide[binary_variables[k]] = values[k] / LEVELS;
+    }
+
+    return objectives_[entry];
+}
+
+std::size_t orcs::RelaxationCache::size() const {
+    return size_;
+}
+
+double orcs::RelaxationCache::distance(std::size_t entry) const {
+
+    std::size_t nb = candidate_.size();
+    const std::uint8_t* values = values_.data() + entry * nb;
+
+    unsigned long long sum = 0;
+    for (std::size_t k = 0; k < nb; ++k) {
+        sum += (values[k] > candidate_[k] ? values[k] - candidate_[k] : candidate_[k] - values[k]);
+    }
+
+    return sum / (LEVELS * nb);
+}
@@ -0,0 +1,114 @@
+#ifndef ORCS_RELAXATION_CACHE_H
+#define ORCS_RELAXATION_CACHE_H
+
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <random>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class keeps a bounded set of (diverse) LP relaxation solutions of the
+ * nodes of the branch-and-cut tree, used by heuristics as guides. Only the
+ * values of the binary variables are stored, each one quantized to a single
+ * byte. A relaxation is admitted if its (normalized L1) distance to the
+ * incumbent solution and to all relaxations in the cache is at least a given
+ * diversity. When the cache is full, the new relaxation replaces the least
+ * diverse one (i.e., the one closest to another relaxation), provided that the
+ * new one is more diverse.
+ */
+class RelaxationCache {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   capacity
+     *          The maximum number of relaxations kept in the cache.
+     * @param   min_diversity
+     *          The minimum (normalized) distance of an admitted relaxation to
+     *          the incumbent solution and to the other relaxations.
+     */
+    RelaxationCache(std::size_t capacity, double min_diversity);
+
+    /**
+     * Offer a relaxation to the cache.
+     *
+     * @param   relaxation
+     *          The values of the variables in the LP relaxation.
+     * @param   objective
+     *          The value of the objective function of the LP relaxation.
+     * @param   incumbent
+     *          The values of the variables in the incumbent solution.
+     * @param   binary_variables
+     *          Indexes of the binary variables of the problem (the same ones
+     *          on every call).
+     *
+     * @return  True if the relaxation was admitted into the cache, false
+     *          otherwise.
+     */
+    bool offer(const IloNumArray& relaxation, double objective, const IloNumArray& incumbent,
+            const std::vector<std::size_t>& binary_variables);
+
+    /**
+     * Sample (uniformly) a relaxation from the cache. The cache must not be
+     * empty.
+     *
+     * @param   rng
+     *          The random number generator.
+     * @param   guide
+     *          The values of the binary variables in the relaxation sampled
+     *          are written into this array (other values are untouched).
+     * @param   binary_variables
+     *          Indexes of the binary variables of the problem.
+     *
+     * @return  The value of the objective function of the relaxation sampled.
+     */
+    double sample(std::mt19937& rng, IloNumArray& guide,
+            const std::vector<std::size_t>& binary_variables) const;
+
+    /**
+     * Return the number of relaxations in the cache.
+     *
+     * @return  The number of relaxations in the cache.
+     */
+    std::size_t size() const;
+
+private:
+
+    /**
+     * Return the normalized L1 distance between a stored relaxation and the
+     * quantized candidate.
+     */
+    double distance(std::size_t entry) const;
+
+    std::size_t capacity_;
+    double min_diversity_;
+
+    /*
+     * Quantized values of the relaxations (one row of bytes per relaxation), their objective values and the distance of each
+     * one to its nearest relaxation (or to the incumbent at its admission).
+     */
+    std::vector<std::uint8_t> values_;
+    std::vector<double> objectives_;
+    std::vector<double> nearest_;
+    std::size_t size_;
+
+    /*
+     * Quantized candidate and its distances to the stored relaxations.
+     */
+    std::vector<std::uint8_t> candidate_;
+    std::vector<double> distances_;
+
+    static constexpr double LEVELS = 255.0;
+};
+
+}
+
+#endif
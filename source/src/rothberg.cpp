@@ -1,27 +1,38 @@
 #include "rothberg.h"
-#include "abort_callback.h"
 #include <cmath>
+#include <string>
 #include <limits>
+#include <iomanip>
 #include <algorithm>
 
 
-orcs::Rothberg::Rothberg(ProblemData* problem, SolutionPool* pool,
-        const cxxproperties::Properties* params) :
-        problem_(problem), submip_(problem->env, problem->filename), pool_(pool)
+orcs::Rothberg::Rothberg(ProblemData* problem, const HeuristicParameters& params,
+        const RothbergParameters& rothberg_params) :
+        problem_(problem), submip_(problem->filename), pool_(nullptr),
+        submip_solver_(&submip_, params.submip),
+        fixing_scores_(problem, params.fixing_strategy, submip_.variables.getSize()),
+        predictor_(params.predictor),
+        weights_(submip_.variables.getSize(), 1.0), mutation_batch_(rothberg_params.batch),
+        recombination_batch_(rothberg_params.batch), local_branching_active_(false), binaries_free_(false)
 {
 
     // Heuristic parameters
-    num_recombinations_ = params->get<long>("recombinations", 40);
-    num_mutations_ = params->get<long>("mutations", 20);
-    fixing_fraction_ = params->get<double>("fixing-fraction", 0.5);
-    offset_ = params->get<double>("offset-init", 0.2);
-    offset_reduction_ = params->get<double>("offset-reduction", 0.25);
-    offset_minimum_ = params->get<double>("offset-minimum", 0.01);
+    num_recombinations_ = rothberg_params.recombinations;
+    num_mutations_ = rothberg_params.mutations;
+    fixing_fraction_ = rothberg_params.fixing_fraction;
+    offset_ = rothberg_params.offset_init;
+    offset_reduction_ = rothberg_params.offset_reduction;
+    offset_minimum_ = rothberg_params.offset_minimum;
+
+    neighborhood_ = (rothberg_params.local_branching ? Neighborhood::LOCAL_BRANCHING : Neighborhood::FIXING);
+    connected_sampling_ = params.connected_sampling;
+    widening_steps_ = params.submip.widening_steps;
+    widening_batch_ = params.submip.widening_batch;
+    batch_size_ = rothberg_params.batch;
 
     // Other parameters
-    seed_ = params->get<int>("seed", 0);
-    submip_nodes_limit_ = params->get<long>("submip-nodes-limit", 500);
-    submip_nodes_unsuccessful_ = params->get<long>("submip-nodes-unsuccessful", std::numeric_limits<long>::max());
+    seed_ = params.submip.seed;
+    submip_nodes_limit_ = params.submip.nodes_limit;
 
     // Set CPLEX instance used to solve sub-MIPs
     submip_.cplex.setOut(submip_.env.getNullStream());
@@ -34,114 +45,331 @@ orcs::Rothberg::Rothberg(ProblemData* problem, SolutionPool* pool,
     submip_.cplex.setParam(IloCplex::Param::MIP::Strategy::RINSHeur, 0);
     submip_.cplex.setParam(IloCplex::Param::MIP::Strategy::LBHeur, false);
 
-    // Identify binary variables
-    for (std::size_t i = 0; i < problem_->variables.getSize(); ++i) {
-        if (problem_->variables[i].getType() == IloNumVar::Type::Bool ||
-            (problem_->variables[i].getType() == IloNumVar::Type::Int &&
-             std::abs(problem_->variables[i].getLB()) < THRESHOLD &&
-             std::abs(problem_->variables[i].getUB() - 1.0) < THRESHOLD)) {
+    // Identify binary variables (on the copy of the problem, since the
+    // heuristic may be built while the problem is being solved)
+    for (std::size_t i = 0; i < submip_.variables.getSize(); ++i) {
+        if (submip_.variables[i].getType() == IloNumVar::Type::Bool ||
+            (submip_.variables[i].getType() == IloNumVar::Type::Int &&
+             std::abs(submip_.variables[i].getLB()) < THRESHOLD &&
+             std::abs(submip_.variables[i].getUB() - 1.0) < THRESHOLD)) {
             binary_variables_.push_back(i);
         }
     }
 
+    // Local branching constraint (inactive until the first local branching
+    // neighborhood is built)
+    sorted_binary_variables_ = binary_variables_;
+    local_branching_indices_ = binary_variables_;
+    local_branching_variables_ = IloNumVarArray(submip_.env, binary_variables_.size());
+    local_branching_coefs_ = IloNumArray(submip_.env, binary_variables_.size());
+    for (std::size_t j = 0; j < binary_variables_.size(); ++j) {
+        local_branching_variables_[j] = submip_.variables[binary_variables_[j]];
+        local_branching_coefs_[j] = 0.0;
+    }
+
+    if (neighborhood_ == Neighborhood::LOCAL_BRANCHING) {
+        local_branching_ = IloRange(submip_.env, -IloInfinity, IloInfinity);
+        submip_.model.add(local_branching_);
+    }
+
+    // Nested heuristic (recursive polishing), which explores large sub-MIPs
+    // by smaller ones on its own copy of the problem (nested sub-MIPs are not
+    // split into components, to bound the number of copies of the problem)
+    nested_ = nullptr;
+    if (params.submip.recursion_depth > 0) {
+        HeuristicParameters nested_params = params;
+        nested_params.submip.recursion_depth -= 1;
+        nested_params.submip.seed += 1;
+        nested_params.submip.split_components = false;
+        nested_params.submip.workers = 0;
+        nested_ = new Rothberg(&submip_, nested_params, rothberg_params);
+        submip_solver_.set_nested(nested_);
+    }
+
     // Initialize the random number generator
     random_.seed(seed_);
 }
 
-void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback, 
-        const cxxtimer::Timer* timer, double time_limit) {
+orcs::Rothberg::~Rothberg() {
+    if (nested_ != nullptr) {
+        delete nested_;
+    }
+}
+
+void orcs::Rothberg::run(const HeuristicContext& context) {
+
+    // Need a pool and an incumbent solution
+    if (context.pool == nullptr || context.incumbent.empty()) {
+        return;
+    }
+
+    ++statistics_.calls;
+
+    // Solutions of the pool may be used as MIP starts of sub-MIPs
+    pool_ = context.pool;
+    submip_solver_.set_pool(pool_, &binary_variables_);
+
+    // Sub-MIPs are preempted by better solutions found elsewhere
+    submip_solver_.set_broadcast(context.broadcast);
+
+    // Neighborhoods are not repeated within a call (batches are generated over
+    // the binary variables in a stable order, since the neighborhoods are
+    // identified by their bits)
+    mutation_batch_.clear();
+    recombination_batch_.clear();
 
     // Get the incumbent solution
-    double incumbent_objective = callback->getIncumbentObjValue();
+    double incumbent_objective = context.incumbent_objective;
     IloNumArray incumbent_solution(problem_->env, problem_->variables.getSize());
-    problem_->cplex.getValues(incumbent_solution, problem_->variables);
+    for (std::size_t j = 0; j < (std::size_t) incumbent_solution.getSize(); ++j) {
+        incumbent_solution[j] = context.incumbent[j];
+    }
     
-    // Mutations (need at least one feasible solution)
+    // Mutations (need at least one feasible solution). Random fixing
+    // neighborhoods can be generated in batches.
+    bool batched_mutations = (batch_size_ > 1 && neighborhood_ == Neighborhood::FIXING &&
+            !connected_sampling_ && fixing_scores_.strategy() == FixingScores::Strategy::RANDOM);
     if (pool_->size() >= 1) {
         
         for (long i = 0; i < num_mutations_; ++i) {
             
             // Check timer (stop criterion)
-            if (timer != nullptr && (timer->count<std::chrono::milliseconds>() / 1000.0) >= time_limit) {
+            if (context.expired()) {
                 break;
             }
             
             // Unextract previous model in CPLEX solver
             submip_.cplex.clear();
             
-            // Randomly select a seed solution
-            std::size_t idx = random_() % pool_->size();
-            if (idx != 0) {
-                std::size_t idx_aux = random_() % idx;
-                idx = idx_aux;
+            // Randomly select a seed solution (batched neighborhoods come
+            // with their seed solutions)
+            NeighborhoodBatch::Neighborhood batched;
+            const SolutionPool::Entry* seed = nullptr;
+            if (batched_mutations) {
+                seed = next_batched(mutation_batch_, true, batched);
+                if (seed == nullptr) {
+                    break;
+                }
+            } else {
+                std::size_t idx = random_() % pool_->size();
+                if (idx != 0) {
+                    std::size_t idx_aux = random_() % idx;
+                    idx = idx_aux;
+                }
+                seed = &(pool_->get_entries()[idx]);
             }
-            const SolutionPool::Entry& entry = pool_->get_entries()[idx];
-            
-            // Define the size of the sub-MIP
-            std::size_t count_fixed_variables = (std::size_t) std::round(binary_variables_.size() * fixing_fraction_);
+            const SolutionPool::Entry& entry = *seed;
             
+            // Size of the neighborhood (kept to widen it, if necessary)
+            IloNum radius = 0.0;
+            IloNum count_ones = 0.0;
+            std::size_t count_fixed_variables = 0;
+
             // Build the sub-MIP
-            std::shuffle(binary_variables_.begin(), binary_variables_.end(), random_);
-            for (std::size_t j = 0; j < binary_variables_.size(); ++j) {
-                std::size_t index = binary_variables_[j];
-                if (j < count_fixed_variables) {
-                    IloNum value_to_fix = (entry.solution[index] > 0.5 ? 1.0 : 0.0);
-                    submip_.variables[index].setLB(value_to_fix);
-                    submip_.variables[index].setUB(value_to_fix);
+            if (neighborhood_ == Neighborhood::LOCAL_BRANCHING) {
+
+                // Release binary variables fixed by a previous sub-MIP
+                release_binaries();
+
+                // Define the neighborhood radius (the number of binary
+                // variables allowed to flip its value)
+                radius = std::max(1.0, std::round(binary_variables_.size() * (1.0 - fixing_fraction_)));
+
+                // Update the local branching constraint around the seed solution:
+                // sum_{j: x'_j = 0} x_j + sum_{j: x'_j = 1} (1 - x_j) <= radius
+                for (std::size_t j = 0; j < (std::size_t) local_branching_variables_.getSize(); ++j) {
+                    if (entry.solution[local_branching_indices_[j]] > 0.5) {
+                        local_branching_coefs_[j] = -1.0;
+                        count_ones += 1.0;
+                    } else {
+                        local_branching_coefs_[j] = 1.0;
+                    }
+                }
+
+                local_branching_.setLinearCoefs(local_branching_variables_, local_branching_coefs_);
+                local_branching_.setUB(radius - count_ones);
+                local_branching_active_ = true;
+
+            } else {
+
+                // Define the size of the sub-MIP
+                count_fixed_variables = (std::size_t) std::round(binary_variables_.size() * fixing_fraction_);
+
+                // Order the binary variables (the first ones are fixed)
+                if (batched_mutations) {
+
+                    // Fixed variables of the mask first (in random order, so
+                    // widening frees random ones)
+                    const std::vector<std::size_t>& indexes = mutation_batch_.indexes();
+                    std::vector<std::size_t> free_variables;
+                    free_variables.reserve(batched.num_free);
+                    binary_variables_.clear();
+                    for (std::size_t k = 0; k < indexes.size(); ++k) {
+                        if (batched.fixed.get(k)) {
+                            binary_variables_.push_back(indexes[k]);
+                        } else {
+                            free_variables.push_back(indexes[k]);
+                        }
+                    }
+
+                    count_fixed_variables = binary_variables_.size();
+                    std::shuffle(binary_variables_.begin(), binary_variables_.end(), random_);
+                    binary_variables_.insert(binary_variables_.end(), free_variables.begin(),
+                            free_variables.end());
+
+                } else if (connected_sampling_) {
+
+                    // Grow the set of free variables along the constraints
+                    // (variables safe to fix are less likely to be free)
+                    fixing_scores_.update(context, entry.solution, binary_variables_);
+                    for (auto idx : binary_variables_) {
+                        weights_[idx] = 1.0 - fixing_scores_[idx];
+                    }
+
+                    sampler_.sample(submip_solver_.graph(), binary_variables_, weights_,
+                            binary_variables_.size() - count_fixed_variables, random_, selected_);
+
+                    // Move the free variables to the end
+                    std::vector<char> keep_free(problem_->variables.getSize(), 0);
+                    for (auto idx : selected_) {
+                        keep_free[idx] = 1;
+                    }
+
+                    std::stable_partition(binary_variables_.begin(), binary_variables_.end(),
+                            [&keep_free](std::size_t idx) { return keep_free[idx] == 0; });
+
+                } else if (fixing_scores_.strategy() == FixingScores::Strategy::RANDOM) {
+                    std::shuffle(binary_variables_.begin(), binary_variables_.end(), random_);
                 } else {
-                    submip_.variables[index].setLB(problem_->variables[index].getLB());
-                    submip_.variables[index].setUB(problem_->variables[index].getUB());
+                    fixing_scores_.update(context, entry.solution, binary_variables_);
+                    fixing_scores_.order(binary_variables_, random_);
+                }
+
+                for (std::size_t j = 0; j < binary_variables_.size(); ++j) {
+                    std::size_t index = binary_variables_[j];
+                    if (j < count_fixed_variables) {
+                        IloNum value_to_fix = (entry.solution[index] > 0.5 ? 1.0 : 0.0);
+                        submip_.variables[index].setLB(value_to_fix);
+                        submip_.variables[index].setUB(value_to_fix);
+                    } else {
+                        submip_.variables[index].setLB(problem_->variables[index].getLB());
+                        submip_.variables[index].setUB(problem_->variables[index].getUB());
+                    }
                 }
+
+                binaries_free_ = false;
             }
-            
-            // Extract sub-MIP model into CPLEX solver
-            submip_.cplex.extract(submip_.model);
 
-            // Set sub-MIP abort callback
-            submip_.cplex.use(orcs::AbortCallback::create_instance(submip_.env, timer,
-                    time_limit, std::numeric_limits<unsigned long long>::max(),
-                    submip_nodes_unsuccessful_));
+            // Resample the neighborhood, if it is unlikely to succeed
+            bool local_branching = (neighborhood_ == Neighborhood::LOCAL_BRANCHING);
+            double seed_value = entry.value;
+            SuccessPredictor::Features features;
+            if (predictor_.enabled()) {
+                features = predictor_.describe(submip_, binary_variables_, entry.solution,
+                        seed_value, incumbent_objective, *pool_, context.relaxation,
+                        (local_branching ? SuccessPredictor::Operator::LOCAL_BRANCHING :
+                                SuccessPredictor::Operator::FIXING));
+                if (local_branching) {
+                    features.free_fraction = radius / binary_variables_.size();
+                }
 
-            // Optimize the sub-MIP
-            bool submip_found_solution = submip_.cplex.solve();
-            IloAlgorithm::Status submip_status = submip_.cplex.getStatus();
+                if (!predictor_.accept(features, random_)) {
+                    --i;
+                    continue;
+                }
+            }
+            
+            // Optimize the sub-MIP (the seed solution lies inside local
+            // branching neighborhoods, so it is used as MIP start, and the
+            // local branching constraint couples all binary variables)
+            submip_solver_.set_incumbent(incumbent_objective);
+            bool submip_found_solution = submip_solver_.solve(entry.solution,
+                    (local_branching ? &entry.solution : nullptr),
+                    context.timer, context.time_limit, !local_branching);
+            IloAlgorithm::Status submip_status = submip_solver_.status();
 
-            // Check if some solution was found
             bool submip_has_improved = false;
-            if (submip_found_solution) {
+            bool submip_has_succeeded = false;
+            long widening_step = 0;
+            while (true) {
 
-                // Get the solution
-                SolutionPool::Entry current_entry {
-                        IloNumArray(submip_.env, submip_.variables.getSize()),
-                        submip_.cplex.getObjValue(), 0};
+                // Check if some solution was found
+                if (submip_found_solution) {
 
-                submip_.cplex.getValues(current_entry.solution, submip_.variables);
+                    // Get the solution
+                    SolutionPool::Entry current_entry {
+                            submip_solver_.solution(), submip_solver_.objective(), 0};
 
-                // Update the solution pool
-                pool_->add_entry(current_entry.solution, current_entry.value);
+                    // Update the solution pool
+                    pool_->add_entry(current_entry.solution, current_entry.value);
 
-                // Check if the new solution is better than the current incumbent
-                if ((submip_.objective.getSense() == IloObjective::Minimize &&
-                     current_entry.value < incumbent_objective - THRESHOLD) ||
-                    (submip_.objective.getSense() == IloObjective::Maximize &&
-                     current_entry.value > incumbent_objective + THRESHOLD)) {
+                    // Check if the new solution is better than the seed solution
+                    submip_has_succeeded = submip_has_succeeded ||
+                            (submip_.objective.getSense() == IloObjective::Minimize ?
+                             current_entry.value < seed_value - THRESHOLD :
+                             current_entry.value > seed_value + THRESHOLD);
 
-                    // Update the incumbent solution
-                    incumbent_objective = current_entry.value;
-                    for (std::size_t idx = 0; idx < incumbent_solution.getSize(); ++idx) {
-                        incumbent_solution[idx] = current_entry.solution[idx];
+                    // Check if the new solution is better than the current incumbent
+                    if ((submip_.objective.getSense() == IloObjective::Minimize &&
+                         current_entry.value < incumbent_objective - THRESHOLD) ||
+                        (submip_.objective.getSense() == IloObjective::Maximize &&
+                         current_entry.value > incumbent_objective + THRESHOLD)) {
+
+                        // Update the incumbent solution
+                        incumbent_objective = current_entry.value;
+                        for (std::size_t idx = 0; idx < incumbent_solution.getSize(); ++idx) {
+                            incumbent_solution[idx] = current_entry.solution[idx];
+                        }
+
+                        // Set flag of improved solution found
+                        submip_has_improved = true;
                     }
+                }
 
-                    // Set flag of improved solution found
-                    submip_has_improved = true;
+                // Widen the neighborhood if the sub-MIP has been solved to
+                // optimality without improvement (the same sub-MIP is solved
+                // again with a larger radius or a batch of variables freed)
+                if (submip_has_improved || widening_step >= widening_steps_ ||
+                        submip_status != IloAlgorithm::Status::Optimal ||
+                        !submip_solver_.resolvable() ||
+                        (!local_branching && count_fixed_variables == 0) ||
+                        (local_branching && radius >= binary_variables_.size()) ||
+                        context.expired()) {
+                    break;
                 }
 
-                // Free resources
-                current_entry.solution.end();
+                ++widening_step;
+                std::size_t batch = std::max<std::size_t>(1,
+                        (std::size_t) (binary_variables_.size() * widening_batch_));
+
+                if (local_branching) {
+                    radius += batch;
+                    local_branching_.setUB(radius - count_ones);
+                } else {
+
+                    // Free the last fixed variables (the least safe to fix)
+                    batch = std::min(batch, count_fixed_variables);
+                    for (std::size_t j = count_fixed_variables - batch; j < count_fixed_variables; ++j) {
+                        std::size_t index = binary_variables_[j];
+                        submip_.variables[index].setLB(problem_->variables[index].getLB());
+                        submip_.variables[index].setUB(problem_->variables[index].getUB());
+                    }
+                    count_fixed_variables -= batch;
+                }
+
+                submip_found_solution = submip_solver_.resolve(context.timer, context.time_limit);
+                submip_status = submip_solver_.status();
+            }
+
+            // Learn from the outcome of the neighborhood (a sub-MIP preempted
+            // by a better solution found elsewhere is not a failure)
+            if (predictor_.enabled() && (submip_has_succeeded || !submip_solver_.preempted())) {
+                predictor_.update(features, submip_has_succeeded);
             }
 
-            // Update the fixing fraction
-            if (!submip_has_improved) {
+            // Update the fixing fraction (unless the sub-MIP was preempted,
+            // which says nothing about its size)
+            if (!submip_has_improved && !submip_solver_.preempted()) {
                 if (submip_status == IloAlgorithm::Status::Optimal ||
                     submip_status == IloAlgorithm::Status::Infeasible) {
 
@@ -161,26 +389,41 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
         offset_ = std::max(offset_minimum_, offset_);
     }
     
-    // Recombinations (need at least two feasible solutions)
-    if (pool_->size() >= 2) {
+    // Recombinations (need at least two feasible solutions, and they are
+    // disabled if their number is zero)
+    if (pool_->size() >= 2 && num_recombinations_ > 0) {
         
         // Define which iteration of Recombination will consider all solutions
         long consider_all = random_() % (num_recombinations_);
+        bool batched_recombinations = (batch_size_ > 1);
         
         for (long i = 0; i < num_recombinations_; ++i) {
             
             // Check timer (stop criterion)
-            if (timer != nullptr && (timer->count<std::chrono::milliseconds>() / 1000.0) >= time_limit) {
+            if (context.expired()) {
                 break;
             }
             
             // Unextract previous model in CPLEX solver
             submip_.cplex.clear();
             
+            // Recombinations do not use the local branching constraint
+            deactivate_local_branching();
+
             // Start solution (cutoff)
             const IloNumArray* start_sol = nullptr;
             IloNum start_obj;
 
+            // Take the next pair of solutions of the batch
+            NeighborhoodBatch::Neighborhood batched;
+            const SolutionPool::Entry* seed = nullptr;
+            if (batched_recombinations && i != consider_all) {
+                seed = next_batched(recombination_batch_, false, batched);
+                if (seed == nullptr) {
+                    break;
+                }
+            }
+
             // Build the sub-MIP
             if (i == consider_all) {
             // Consider all solutions into the pool
@@ -196,6 +439,7 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
                     }
 
                     if (fix) {
+                        binaries_free_ = false;
                         submip_.variables[idx].setLB(value);
                         submip_.variables[idx].setUB(value);
                     } else {
@@ -208,6 +452,27 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
                 start_sol = &(pool_->get_entries()[0].solution);
                 start_obj = pool_->get_entries()[0].value;
                 
+            } else if (seed != nullptr) {
+            // Consider a pair of solutions of the batch
+
+                const std::vector<std::size_t>& indexes = recombination_batch_.indexes();
+                for (std::size_t k = 0; k < indexes.size(); ++k) {
+                    std::size_t idx = indexes[k];
+                    if (batched.fixed.get(k)) {
+                        binaries_free_ = false;
+                        IloNum value_to_fix = (batched.values.get(k) ? 1.0 : 0.0);
+                        submip_.variables[idx].setLB(value_to_fix);
+                        submip_.variables[idx].setUB(value_to_fix);
+                    } else {
+                        submip_.variables[idx].setLB(problem_->variables[idx].getLB());
+                        submip_.variables[idx].setUB(problem_->variables[idx].getUB());
+                    }
+                }
+
+                // Get the start solution
+                start_sol = &(seed->solution);
+                start_obj = seed->value;
+
             } else {
             // Consider only a pair of solutions
             
@@ -221,6 +486,7 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
                 
                 for (auto idx : binary_variables_) {
                     if (std::abs(entry1.solution[idx] - entry2.solution[idx]) < THRESHOLD) {
+                        binaries_free_ = false;
                         IloNum value_to_fix = (entry1.solution[idx] > 0.5 ? 1.0 : 0.0);
                         submip_.variables[idx].setLB(value_to_fix);
                         submip_.variables[idx].setUB(value_to_fix);
@@ -235,9 +501,6 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
                 start_obj = entry1.value;
             }
             
-            // Extract sub-MIP model into CPLEX solver
-            submip_.cplex.extract(submip_.model);
-            
             // Set cutoff
             //if (submip_.objective.getSense() == IloObjective::Minimize) {
             //    submip_.cplex.setParam(IloCplex::Param::MIP::Tolerances::UpperCutoff, start_obj);
@@ -245,27 +508,35 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
             //    submip_.cplex.setParam(IloCplex::Param::MIP::Tolerances::LowerCutoff, start_obj);
             //}
 
-            // Set a MIP start solution
-            submip_.cplex.addMIPStart(submip_.variables, *start_sol);
-
-            // Set sub-MIP abort callback
-            submip_.cplex.use(orcs::AbortCallback::create_instance(submip_.env, timer,
-                    time_limit, std::numeric_limits<unsigned long long>::max(),
-                    submip_nodes_unsuccessful_));
+            // Resample the neighborhood, if it is unlikely to succeed
+            SuccessPredictor::Features features;
+            if (predictor_.enabled()) {
+                features = predictor_.describe(submip_, binary_variables_, *start_sol, start_obj,
+                        incumbent_objective, *pool_, context.relaxation,
+                        SuccessPredictor::Operator::RECOMBINATION);
+                if (!predictor_.accept(features, random_)) {
+                    --i;
+                    continue;
+                }
+            }
 
-            // Solve the sub-MIP
-            if (submip_.cplex.solve()) {
+            // Solve the sub-MIP (with a MIP start solution)
+            submip_solver_.set_incumbent(incumbent_objective);
+            bool submip_has_succeeded = false;
+            if (submip_solver_.solve(*start_sol, start_sol, context.timer, context.time_limit)) {
                 
                 // Get the solution found
                 SolutionPool::Entry current_entry {
-                        IloNumArray(submip_.env, submip_.variables.getSize()), 
-                        submip_.cplex.getObjValue(), 0};
-
-                submip_.cplex.getValues(current_entry.solution, submip_.variables);
+                        submip_solver_.solution(), submip_solver_.objective(), 0};
                 
                 // Update the solution pool
                 pool_->add_entry(current_entry.solution, current_entry.value);
 
+                // Check if the new solution is better than the start solution
+                submip_has_succeeded = (submip_.objective.getSense() == IloObjective::Minimize ?
+                        current_entry.value < start_obj - THRESHOLD :
+                        current_entry.value > start_obj + THRESHOLD);
+
                 // Check if the new solution is better than the current incumbent
                 if ((submip_.objective.getSense() == IloObjective::Minimize &&
                         current_entry.value < incumbent_objective - THRESHOLD) ||
@@ -278,16 +549,105 @@ void orcs::Rothberg::run(IloCplex::HeuristicCallbackI* callback,
                         incumbent_solution[i] = current_entry.solution[i];
                     }
                 }
-                
-                // Free resources
-                current_entry.solution.end();
+            }
+
+            // Learn from the outcome of the neighborhood (a sub-MIP preempted
+            // by a better solution found elsewhere is not a failure)
+            if (predictor_.enabled() && (submip_has_succeeded || !submip_solver_.preempted())) {
+                predictor_.update(features, submip_has_succeeded);
             }
         }
     }
     
-    // Let CPLEX know about a possible new incumbent solution
-    callback->setSolution(problem_->variables, incumbent_solution);
+    // Count the improvement of the incumbent solution
+    if (problem_->objective.getSense() == IloObjective::Minimize ?
+            incumbent_objective < context.incumbent_objective - THRESHOLD :
+            incumbent_objective > context.incumbent_objective + THRESHOLD) {
+        ++statistics_.improvements;
+    }
+
+    // Hand a possible new incumbent solution to the caller
+    if (context.submit) {
+        std::vector<double> best(incumbent_solution.getSize());
+        for (std::size_t j = 0; j < best.size(); ++j) {
+            best[j] = incumbent_solution[j];
+        }
+        context.submit(ValueSpan(best), incumbent_objective);
+    }
     
     // Free resources
     incumbent_solution.end();
 }
+
+orcs::HeuristicStatistics orcs::Rothberg::statistics() const {
+    HeuristicStatistics statistics = statistics_;
+    statistics.submips = submip_solver_.num_solved();
+    statistics.skipped = predictor_.num_rejected();
+    if (nested_ != nullptr) {
+        statistics.submips += nested_->statistics().submips;
+        statistics.skipped += nested_->statistics().skipped;
+    }
+    return statistics;
+}
+
+void orcs::Rothberg::write_state(std::ostream& output) const {
+    output << std::setprecision(17) << fixing_fraction_ << " " << offset_ << " "
+           << statistics_.calls << " " << statistics_.improvements << " " << random_ << "\n";
+    predictor_.write_state(output);
+    if (nested_ != nullptr) {
+        nested_->write_state(output);
+    }
+}
+
+void orcs::Rothberg::read_state(std::istream& input) {
+    input >> fixing_fraction_ >> offset_ >> statistics_.calls >> statistics_.improvements >> random_;
+    if (!input) {
+        throw std::string("Invalid state of the heuristic.");
+    }
+    predictor_.read_state(input);
+    if (nested_ != nullptr) {
+        nested_->read_state(input);
+    }
+}
+
+void orcs::Rothberg::release_binaries() {
+    if (!binaries_free_) {
+        for (auto idx : binary_variables_) {
+            submip_.variables[idx].setLB(problem_->variables[idx].getLB());
+            submip_.variables[idx].setUB(problem_->variables[idx].getUB());
+        }
+
+        binaries_free_ = true;
+    }
+}
+
+void orcs::Rothberg::deactivate_local_branching() {
+    if (local_branching_active_) {
+        local_branching_.setUB(IloInfinity);
+        local_branching_active_ = false;
+    }
+}
+
+const orcs::SolutionPool::Entry* orcs::Rothberg::next_batched(NeighborhoodBatch& batch,
+        bool mutation, NeighborhoodBatch::Neighborhood& neighborhood) {
+
+    while (true) {
+
+        // Generate a new batch, if the pending neighborhoods are exhausted
+        if (!batch.pop(neighborhood)) {
+            std::size_t generated = (mutation ?
+                    batch.mutations(*pool_, sorted_binary_variables_, fixing_fraction_, random_) :
+                    batch.recombinations(*pool_, sorted_binary_variables_, random_));
+            if (generated == 0 || !batch.pop(neighborhood)) {
+                return nullptr;
+            }
+        }
+
+        // Skip neighborhoods whose seed solution has left the pool
+        for (const auto& entry : pool_->get_entries()) {
+            if (entry.age == neighborhood.seed_age) {
+                return &entry;
+            }
+        }
+    }
+}
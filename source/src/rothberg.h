@@ -4,11 +4,16 @@
 #include "problem_data.h"
 #include "solution_pool.h"
 #include "heuristic.h"
+#include "fixing_scores.h"
+#include "success_predictor.h"
+#include "neighborhood_batch.h"
+#include "submip_solver.h"
+#include "graph_sampler.h"
+#include "parameters.h"
 #include <cstdlib>
 #include <vector>
 #include <random>
 #include <ilcplex/ilocplex.h>
-#include <cxxproperties.hpp>
 
 ILOSTLBEGIN
 
@@ -24,37 +29,92 @@ namespace orcs {
 class Rothberg : public Heuristic {
     
 public:
+
+    /**
+     * Types of neighborhoods explored by mutation sub-MIPs. FIXING fixes a
+     * random fraction of the binary variables to the values of a seed
+     * solution (as originally proposed). LOCAL_BRANCHING keeps all binary
+     * variables free and restricts the sub-MIP to solutions within a given
+     * Hamming distance of the seed solution by a local branching constraint.
+     */
+    enum class Neighborhood { FIXING, LOCAL_BRANCHING };
     
     /**
-     * Constructor.
+     * Constructor. It only reads the name of the file of the problem (the
+     * heuristic loads its own copy), so it may be called while the problem is
+     * being solved by another thread.
      *
      * @param   problem
      *          Pointer to problem data.
-     * @param   pool
-     *          Pointer to solution pool.
      * @param   params
-     *          Pointer to a properties structure with the heuristic parameters.
+     *          The parameters shared by the heuristics.
+     * @param   rothberg_params
+     *          The parameters of Rothberg's heuristic.
      */
-    Rothberg(ProblemData* problem, SolutionPool* pool,
-            const cxxproperties::Properties* params = nullptr);
+    Rothberg(ProblemData* problem, const HeuristicParameters& params,
+            const RothbergParameters& rothberg_params);
     
     /**
      * Perform the heuristic search.
      * 
-     * @param   callback
-     *          A pointer to the heuristic callback object from which this 
-     *          method is called.
-     * @param   timer
-     *          The timer to get the elapsed time spent on the entire
-     *          optimization process.
-     * @param   time_limit
-     *          The time limit of the optimization process (in seconds).
+     * @param   context
+     *          The incumbent solution, relaxation, pool of solutions, deadline
+     *          and solution sink of this call.
      */
-    void run(IloCplex::HeuristicCallbackI* callback, const cxxtimer::Timer* timer,
-            double time_limit) override;
+    void run(const HeuristicContext& context) override;
+
+    /**
+     * Destructor.
+     */
+    virtual ~Rothberg();
+
+    /**
+     * Return the counters of the work done by the heuristic so far.
+     *
+     * @return  The statistics of the heuristic.
+     */
+    HeuristicStatistics statistics() const override;
+
+    /**
+     * Write the adapted parameters, the counters and the state of the random
+     * number generator of the heuristic.
+     *
+     * @param   output
+     *          The stream to write the state.
+     */
+    void write_state(std::ostream& output) const override;
+
+    /**
+     * Restore the state written by write_state.
+     *
+     * @param   input
+     *          The stream to read the state.
+     */
+    void read_state(std::istream& input) override;
     
 private:
 
+    /**
+     * Restore the original bounds of all binary variables of the sub-MIP, if
+     * any of them is fixed.
+     */
+    void release_binaries();
+
+    /**
+     * Relax the right-hand side of the local branching constraint, if it is
+     * active.
+     */
+    void deactivate_local_branching();
+
+    /**
+     * Take the next neighborhood of a batch (generating a new batch, if the
+     * pending ones are exhausted) whose seed solution is still in the pool.
+     * It returns the seed solution, or nullptr if no new neighborhood is
+     * generated.
+     */
+    const SolutionPool::Entry* next_batched(NeighborhoodBatch& batch, bool mutation,
+            NeighborhoodBatch::Neighborhood& neighborhood);
+
     /*
      * Internal data structures.
      */
@@ -62,7 +122,35 @@ private:
     SolutionPool* pool_;
     ProblemData* problem_;
     ProblemData submip_;
+    SubmipSolver submip_solver_;
+    Rothberg* nested_;
+    HeuristicStatistics statistics_;
     std::vector<std::size_t> binary_variables_;
+    std::vector<std::size_t> sorted_binary_variables_;
+    FixingScores fixing_scores_;
+    SuccessPredictor predictor_;
+    GraphSampler sampler_;
+    std::vector<std::size_t> selected_;
+    std::vector<double> weights_;
+
+    /*
+     * Batches of fixing neighborhoods (only used if the batch size is greater
+     * than one).
+     */
+    NeighborhoodBatch mutation_batch_;
+    NeighborhoodBatch recombination_batch_;
+
+    /*
+     * Local branching constraint of mutation sub-MIPs. It is kept in the
+     * sub-MIP model and only its coefficients and right-hand side are updated
+     * from one neighborhood to another.
+     */
+    IloRange local_branching_;
+    std::vector<std::size_t> local_branching_indices_;
+    IloNumVarArray local_branching_variables_;
+    IloNumArray local_branching_coefs_;
+    bool local_branching_active_;
+    bool binaries_free_;
 
     /**
      * Heuristic parameters.
@@ -73,13 +161,17 @@ private:
     double offset_;
     double offset_reduction_;
     double offset_minimum_;
+    Neighborhood neighborhood_;
+    bool connected_sampling_;
+    long widening_steps_;
+    double widening_batch_;
+    long batch_size_;
 
     /*
      * Other parameters.
      */
     int seed_;
     long submip_nodes_limit_;
-    long submip_nodes_unsuccessful_;
 
 };
 
@@ -7,7 +7,8 @@
 orcs::SolutionPool::SolutionPool(IloEnv& env, IloObjective::Sense sense, 
         std::size_t max_size, bool sorted) : 
         env_(env), sense_(sense), max_size_(max_size), sorted_(sorted), 
-        next_age_(std::numeric_limits<unsigned long long>::max())
+        next_age_(std::numeric_limits<unsigned long long>::max()), 
+        symmetry_(nullptr)
 {
     entries_.reserve(max_size_);
 }
@@ -24,6 +25,18 @@ const std::vector<orcs::SolutionPool::Entry>& orcs::SolutionPool::get_entries()
 
 bool orcs::SolutionPool::add_entry(const IloNumArray& solution, const IloNum value) {
     
+    // Hashes of the solution and of its images under the generators of the
+    // symmetry group and their inverses
+    std::uint64_t hash = 0;
+    images_.clear();
+    if (symmetry_ != nullptr) {
+        hash = symmetry_->hash(solution);
+        for (std::size_t g = 0; g < symmetry_->num_generators(); ++g) {
+            images_.push_back(symmetry_->image_hash(solution, g, false));
+            images_.push_back(symmetry_->image_hash(solution, g, true));
+        }
+    }
+    
     // Used to identify the worst solution into the pool
     std::size_t worst_idx = 0;
     IloNum worst_val = (sense_ == IloObjective::Sense::Minimize ? 
@@ -44,6 +57,14 @@ bool orcs::SolutionPool::add_entry(const IloNumArray& solution, const IloNum val
         if (equal) {
             return false;
         }
+
+        // Check symmetry (whether the entry is an image of the solution)
+        for (std::size_t k = 0; k < images_.size(); ++k) {
+            if (images_[k] == entries_[i].hash &&
+                    symmetry_->is_image(solution, entries_[i].solution, k / 2, k % 2 == 1)) {
+                return false;
+            }
+        }
         
         // Find the worst
         if (((sense_ == IloObjective::Sense::Minimize) ? 
@@ -60,7 +81,8 @@ bool orcs::SolutionPool::add_entry(const IloNumArray& solution, const IloNum val
     // Check whether the pool is full
     if (entries_.size() < max_size_) {
         
-        entries_.emplace_back(IloNumArray(env_, solution.getSize()), value, next_age_);
+        entries_.emplace_back(IloNumArray(env_, solution.getSize()), value, next_age_, 
+                hash);
         for (std::size_t i = 0; i < solution.getSize(); ++i) {
             entries_[entries_.size() - 1].solution[i] = solution[i];
         }
@@ -74,6 +96,7 @@ bool orcs::SolutionPool::add_entry(const IloNumArray& solution, const IloNum val
 
         entries_[worst_idx].value = value;
         entries_[worst_idx].age = next_age_;
+        entries_[worst_idx].hash = hash;
         for (std::size_t i = 0; i < solution.getSize(); ++i) {
             entries_[worst_idx].solution[i] = solution[i];
         }
@@ -103,6 +126,10 @@ bool orcs::SolutionPool::add_entry(const IloNumArray& solution, const IloNum val
     return inserted;
 }
 
+void orcs::SolutionPool::set_symmetry(Symmetry* symmetry) {
+    symmetry_ = symmetry;
+}
+
 std::size_t orcs::SolutionPool::size() const {
     return entries_.size();
 }
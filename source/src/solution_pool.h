@@ -2,7 +2,9 @@
 #define ORCS_SOLUTION_POOL_H
 
 
+#include "symmetry.h"
 #include <cstdlib>
+#include <cstdint>
 #include <vector>
 #include <ilcplex/ilocplex.h>
 
@@ -24,15 +26,18 @@ public:
      * An entry of the pool. Each entry consists of a solution encoded by an 
      * IloNumArray (a CPLEX object) of values assigned to each variable of the 
      * optimization problem and the value of the objective function evaluation 
-     * encoded as a IloNum (a CPLEX object).
+     * encoded as a IloNum (a CPLEX object). If the pool detects symmetric 
+     * solutions, the entry also keeps the hash of its solution.
      */
     struct Entry {
         IloNumArray solution;
         IloNum value;
         unsigned long long age;
+        std::uint64_t hash;
         
-        Entry(IloNumArray solution_, IloNum value_, unsigned long long age_) 
-                : solution(solution_), value(value_), age(age_) {};
+        Entry(IloNumArray solution_, IloNum value_, unsigned long long age_, 
+                std::uint64_t hash_ = 0) 
+                : solution(solution_), value(value_), age(age_), hash(hash_) {};
     };
     
     
@@ -71,12 +76,14 @@ public:
     /**
      * Try to add a new entry into this pool. An entry is added if and only if 
      * the pool does not contain any entry with a similar solution (disregarding 
-     * the value of the objective function). If the pool is full, a new entry is 
-     * added if and only if the pool does not contain any entry with a similar 
-     * solution and the value of the objective function of the new entry is 
-     * better than at least one of the entries into the pool. In this case, the 
-     * new entry replaces the entry of the pool with the worst value of 
-     * objective function.
+     * the value of the objective function). If symmetric solutions are 
+     * detected, a solution that is the image of an entry under a generator of
+     * the symmetry group (or its inverse) is also regarded as similar. If the
+     * pool is full, a new entry is added if and only if the pool does not
+     * contain any entry with a similar solution and the value of the
+     * objective function of the new entry is better than at least one of the
+     * entries into the pool. In this case, the new entry replaces the entry of
+     * the pool with the worst value of objective function.
      * 
      * @param   solution
      *          A solution
@@ -87,6 +94,16 @@ public:
      */
     bool add_entry(const IloNumArray& solution, const IloNum value);
     
+    /**
+     * Set the symmetry of the problem, used to reject solutions that are 
+     * symmetric to the ones in the pool. The pool must be empty.
+     * 
+     * @param   symmetry
+     *          Pointer to the symmetry of the problem (or nullptr, to disable 
+     *          the detection of symmetric solutions).
+     */
+    void set_symmetry(Symmetry* symmetry);
+    
     /**
      * Return the number of entries in this pool.
      * 
@@ -114,6 +131,8 @@ private:
     unsigned long long next_age_;
     std::size_t max_size_;
     std::vector<Entry> entries_;
+    Symmetry* symmetry_;
+    std::vector<std::uint64_t> images_;
     
     static constexpr double SIMILARITY_THRESHOLD = 1e-5;
     
@@ -0,0 +1,96 @@
+#include "submip_backend.h"
+#include "cplex_backend.h"
+#include "constraint_graph.h"
+#include "parameters.h"
+#ifdef ORCS_WITH_HIGHS
+#include "highs_backend.h"
+#endif
+
+
+namespace {
+
+#ifdef ORCS_WITH_HIGHS
+
+/*
+ * Copy the problem of a constraint graph into plain arrays.
+ */
+orcs::BackendModel build_model(const orcs::ConstraintGraph& graph) {
+
+    orcs::BackendModel model;
+    model.maximize = graph.maximize();
+    model.objective_constant = graph.objective_constant();
+
+    for (std::size_t j = 0; j < graph.num_variables(); ++j) {
+        model.objective.push_back(graph.objective_coef(j));
+        model.column_lb.push_back(graph.column_lb(j));
+        model.column_ub.push_back(graph.column_ub(j));
+        model.integer.push_back(graph.column_integer(j));
+    }
+
+    for (std::size_t i = 0; i < graph.num_constraints(); ++i) {
+        model.row_lb.push_back(graph.row_lb(i));
+        model.row_ub.push_back(graph.row_ub(i));
+    }
+
+    model.column_start.push_back(0);
+    for (std::size_t j = 0; j < graph.num_variables(); ++j) {
+        const std::size_t* rows = graph.column_constraints(j);
+        const double* coefs = graph.column_coefs(j);
+        for (std::size_t k = 0; k < graph.column_size(j); ++k) {
+            model.column_rows.push_back(rows[k]);
+            model.column_coefs.push_back(coefs[k]);
+        }
+        model.column_start.push_back(model.column_rows.size());
+    }
+
+    return model;
+}
+
+/*
+ * Copy the stopping criteria of the sub-MIP parameters.
+ */
+orcs::BackendLimits build_limits(const orcs::SubmipParameters& params) {
+
+    orcs::BackendLimits limits;
+    limits.seed = params.seed;
+    limits.nodes_limit = params.nodes_limit;
+    limits.nodes_unsuccessful = params.nodes_unsuccessful;
+    limits.stall_window_nodes = params.stall.window_nodes;
+    limits.stall_window_time = params.stall.window_time;
+    limits.stall_min_progress = params.stall.min_progress;
+
+    return limits;
+}
+
+#endif
+
+}
+
+
+orcs::SubmipBackend* orcs::SubmipBackend::create(const std::string& name,
+        const std::string& filename, [[maybe_unused]] const ConstraintGraph& graph,
+        const SubmipParameters& params) {
+
+#ifdef ORCS_WITH_HIGHS
+    if (name == "highs") {
+        return new HighsBackend(build_model(graph), build_limits(params));
+    }
+#endif
+
+    if (name != "cplex") {
+        throw std::string("Sub-MIP backend not available: " + name + ".");
+    }
+
+    return new CplexBackend(filename, params);
+}
+
+bool orcs::SubmipBackend::available(const std::string& name) {
+
+#ifdef ORCS_WITH_HIGHS
+    if (name == "highs") {
+        return true;
+    }
+#endif
+
+    return (name == "cplex");
+}
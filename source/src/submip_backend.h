@@ -0,0 +1,159 @@
+#ifndef ORCS_SUBMIP_BACKEND_H
+#define ORCS_SUBMIP_BACKEND_H
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cxxtimer.hpp>
+
+
+namespace orcs {
+
+class ConstraintGraph;
+struct SubmipParameters;
+
+/**
+ * Status of a sub-MIP solved by a backend.
+ */
+enum class SubmipStatus { UNKNOWN, FEASIBLE, OPTIMAL, INFEASIBLE };
+
+/**
+ * A problem in plain arrays (constraint matrix in compressed sparse column
+ * format), used to build the copy of the problem of backends that do not read
+ * the file of the problem.
+ */
+struct BackendModel {
+    bool maximize = false;
+    double objective_constant = 0.0;
+    std::vector<double> objective;
+    std::vector<double> column_lb;
+    std::vector<double> column_ub;
+    std::vector<bool> integer;
+    std::vector<double> row_lb;
+    std::vector<double> row_ub;
+    std::vector<std::size_t> column_start;
+    std::vector<std::size_t> column_rows;
+    std::vector<double> column_coefs;
+};
+
+/**
+ * Stopping criteria of the sub-MIPs solved by a backend (nodes explored, nodes
+ * explored without improvement and stall of the relative gap over a window
+ * of nodes or time), and the seed of its random number generator.
+ */
+struct BackendLimits {
+    int seed = 0;
+    long nodes_limit = std::numeric_limits<long>::max();
+    long nodes_unsuccessful = std::numeric_limits<long>::max();
+    unsigned long long stall_window_nodes = std::numeric_limits<unsigned long long>::max();
+    double stall_window_time = std::numeric_limits<double>::max();
+    double stall_min_progress = 0.0;
+};
+
+/**
+ * Interface of the MIP solvers used by the sub-MIP workers. A backend keeps
+ * its own copy of the problem, whose variables are indexed as in the original
+ * problem, and solves it under the bounds set by the worker. Data are
+ * exchanged through plain vectors (and the interface does not depend on
+ * CPLEX), then backends can run in their own threads and be built without
+ * CPLEX.
+ */
+class SubmipBackend {
+
+public:
+
+    /**
+     * Create a backend.
+     *
+     * @param   name
+     *          The name of the backend (cplex or highs).
+     * @param   filename
+     *          Path to file containing the optimization problem.
+     * @param   graph
+     *          The constraint matrix, bounds and types of the variables of the
+     *          problem.
+     * @param   params
+     *          The sub-MIP parameters.
+     *
+     * @return  A pointer to the new backend.
+     */
+    static SubmipBackend* create(const std::string& name, const std::string& filename,
+            const ConstraintGraph& graph, const SubmipParameters& params);
+
+    /**
+     * Return whether a backend is available in this build.
+     *
+     * @param   name
+     *          The name of the backend (cplex or highs).
+     *
+     * @return  True if the backend is available, false otherwise.
+     */
+    static bool available(const std::string& name);
+
+    /**
+     * Destructor.
+     */
+    virtual ~SubmipBackend() {}
+
+    /**
+     * Set the bounds of a variable.
+     *
+     * @param   idx
+     *          The index of the variable.
+     * @param   lb
+     *          The lower bound.
+     * @param   ub
+     *          The upper bound.
+     */
+    virtual void set_bounds(std::size_t idx, double lb, double ub) = 0;
+
+    /**
+     * Set a MIP start solution for the next solve.
+     *
+     * @param   start
+     *          Values assigned to each variable of the problem.
+     */
+    virtual void set_start(const std::vector<double>& start) = 0;
+
+
+    /**
+     * Solve the problem under the current bounds.
+     *
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     * @param   time_limit
+     *          The time limit of the optimization process (in seconds).
+     *
+     * @return  True if a feasible solution was found, false otherwise.
+     */
+    virtual bool solve(const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max()) = 0;
+
+    /**
+     * Return the status of the last solve.
+     *
+     * @return  The status of the last solve.
+     */
+    virtual SubmipStatus status() const = 0;
+
+    /**
+     * Return the value of the objective function of the solution found in the
+     * last solve.
+     *
+     * @return  The value of the objective function.
+     */
+    virtual double objective() const = 0;
+
+    /**
+     * Return the solution found in the last solve.
+     *
+     * @return  The values assigned to each variable of the problem.
+     */
+    virtual const std::vector<double>& solution() const = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,561 @@
+#include "submip_solver.h"
+#include "abort_callback.h"
+#include "heuristic_callback.h"
+#include "pool_callback.h"
+#include "cplex_backend.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+
+orcs::SubmipSolver::SubmipSolver(ProblemData* submip, const SubmipParameters& params) :
+        submip_(submip), status_(IloAlgorithm::Status::Unknown), objective_(0.0),
+        solution_(submip->env, submip->variables.getSize()),
+        start_values_(submip->env, submip->variables.getSize()),
+        incumbent_(std::numeric_limits<double>::quiet_NaN()), broadcast_(nullptr),
+        preempted_(false), found_(false), num_solved_(0),
+        resolvable_(false), target_(std::numeric_limits<double>::quiet_NaN()), graph_(nullptr),
+        placement_(params.placement), pool_(nullptr),
+        polisher_(nullptr), nested_(nullptr), nested_pool_(nullptr), separable_(true)
+{
+    // Parameters
+    submip_nodes_unsuccessful_ = params.nodes_unsuccessful;
+    submip_stall_ = params.stall;
+    early_exit_margin_ = params.early_exit;
+    pool_starts_ = params.pool_starts;
+    split_components_ = params.split_components;
+    component_min_size_ = params.component_min_size;
+    recursion_min_size_ = params.recursion_min_size;
+    recursion_frequency_ = params.recursion_frequency;
+    long num_workers = params.workers;
+
+    // LP used to polish the continuous part of solutions (of mixed problems)
+    if (params.lp_polishing) {
+        bool has_continuous = false;
+        for (std::size_t j = 0; j < (std::size_t) submip_->variables.getSize() && !has_continuous; ++j) {
+            has_continuous = (submip_->variables[j].getType() == IloNumVar::Type::Float);
+        }
+        if (has_continuous) {
+            polisher_ = new ContinuousPolisher(submip_->filename);
+        }
+    }
+
+    // Data structures used to split sub-MIPs into components
+    if (split_components_) {
+        for (std::size_t j = 0; j < (std::size_t) submip_->variables.getSize(); ++j) {
+            integer_.push_back(submip_->variables[j].getType() != IloNumVar::Type::Float);
+        }
+
+        // Each worker loads its copy of the problem on its own core (memory is
+        // allocated on the NUMA node of the thread that first touches it);
+        // backends other than CPLEX build their copies from the graph
+        const ConstraintGraph& constraint_graph = graph();
+        workers_.resize(num_workers, nullptr);
+        std::vector<std::exception_ptr> errors(num_workers);
+        std::vector<std::thread> threads;
+        for (long w = 0; w < num_workers; ++w) {
+            threads.emplace_back([this, w, &params, &constraint_graph, &errors]() {
+                try {
+                    placement_.pin_worker(w);
+                    workers_[w] = new SubmipWorker(submip_->filename, constraint_graph, params);
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto& error : errors) {
+            if (error) {
+                for (auto worker : workers_) {
+                    delete worker;
+                }
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
+
+orcs::SubmipSolver::~SubmipSolver() {
+    for (auto worker : workers_) {
+        delete worker;
+    }
+
+    if (graph_ != nullptr) {
+        delete graph_;
+    }
+
+    if (nested_pool_ != nullptr) {
+        delete nested_pool_;
+    }
+
+    if (polisher_ != nullptr) {
+        delete polisher_;
+    }
+
+    solution_.end();
+    start_values_.end();
+}
+
+bool orcs::SubmipSolver::solve(const IloNumArray& reference, const IloNumArray* start,
+        const cxxtimer::Timer* timer, double time_limit, bool separable) {
+
+    status_ = IloAlgorithm::Status::Unknown;
+    preempted_ = false;
+    resolvable_ = false;
+    separable_ = separable;
+
+    // Try to solve independent components separately
+    bool found = false;
+    if (split_components_ && separable && solve_components(reference, timer, time_limit, found)) {
+        if (found) {
+            polish(timer, time_limit);
+        }
+        return found;
+    }
+
+    // Exit early as soon as the global incumbent is improved by the margin
+    target_ = std::numeric_limits<double>::quiet_NaN();
+    if (early_exit_margin_ >= 0.0 && !std::isnan(incumbent_)) {
+        double margin = THRESHOLD + early_exit_margin_ * (THRESHOLD + std::abs(incumbent_));
+        target_ = (submip_->objective.getSense() == IloObjective::Minimize ?
+                incumbent_ - margin : incumbent_ + margin);
+    }
+
+    found_ = solve_model(start, timer, time_limit, target_, broadcast_);
+    resolvable_ = true;
+    if (found_) {
+        polish(timer, time_limit);
+    }
+
+    return found_;
+}
+
+bool orcs::SubmipSolver::resolvable() const {
+    return resolvable_;
+}
+
+bool orcs::SubmipSolver::resolve(const cxxtimer::Timer* timer, double time_limit) {
+
+    status_ = IloAlgorithm::Status::Unknown;
+
+    // Replace the abort callback of the previous solve
+    submip_->cplex.remove(abort_callback_);
+
+    // Optimize the sub-MIP again, warm started from the solution of the
+    // previous solve (which is still feasible, since bounds were relaxed only)
+    if (found_) {
+        IloNumArray start(submip_->env, solution_.getSize());
+        for (std::size_t j = 0; j < (std::size_t) solution_.getSize(); ++j) {
+            start[j] = solution_[j];
+        }
+        found_ = optimize(&start, timer, time_limit, target_, broadcast_);
+        start.end();
+    } else {
+        found_ = optimize(nullptr, timer, time_limit, target_, broadcast_);
+    }
+
+    if (found_) {
+        polish(timer, time_limit);
+    }
+
+    return found_;
+}
+
+void orcs::SubmipSolver::set_pool(const SolutionPool* pool,
+        const std::vector<std::size_t>* binary_variables) {
+    pool_ = pool;
+
+    // Encodings are kept over a stable order of the binary variables (they
+    // are discarded if the binary variables change)
+    std::vector<std::size_t> binaries;
+    if (binary_variables != nullptr) {
+        binaries = *binary_variables;
+        std::sort(binaries.begin(), binaries.end());
+    }
+
+    if (binaries != binary_variables_) {
+        binary_variables_.swap(binaries);
+        encodings_.clear();
+    }
+}
+
+void orcs::SubmipSolver::set_incumbent(IloNum objective) {
+    incumbent_ = objective;
+}
+
+void orcs::SubmipSolver::set_broadcast(IncumbentBroadcast* broadcast) {
+    broadcast_ = broadcast;
+}
+
+void orcs::SubmipSolver::set_nested(Heuristic* heuristic) {
+    nested_ = heuristic;
+}
+
+IloAlgorithm::Status orcs::SubmipSolver::status() const {
+    return status_;
+}
+
+bool orcs::SubmipSolver::preempted() const {
+    return preempted_;
+}
+
+IloNum orcs::SubmipSolver::objective() const {
+    return objective_;
+}
+
+const IloNumArray& orcs::SubmipSolver::solution() const {
+    return solution_;
+}
+
+unsigned long long orcs::SubmipSolver::num_solved() const {
+    return num_solved_;
+}
+
+const orcs::ConstraintGraph& orcs::SubmipSolver::graph() {
+    if (graph_ == nullptr) {
+        graph_ = new ConstraintGraph(*submip_);
+    }
+
+    return *graph_;
+}
+
+bool orcs::SubmipSolver::solve_model(const IloNumArray* start, const cxxtimer::Timer* timer,
+        double time_limit, double target, IncumbentBroadcast* broadcast) {
+
+    // Extract sub-MIP model into CPLEX solver
+    submip_->cplex.extract(submip_->model);
+
+    return optimize(start, timer, time_limit, target, broadcast);
+}
+
+bool orcs::SubmipSolver::optimize(const IloNumArray* start, const cxxtimer::Timer* timer,
+        double time_limit, double target, IncumbentBroadcast* broadcast) {
+
+    preempted_ = false;
+
+    // Set a MIP start solution
+    if (start != nullptr) {
+        add_start(*start);
+    }
+
+    // Encode the fixings and the pool (used by the MIP starts and by the
+    // nested heuristic)
+    bool nested = nesting();
+    if (pool_ != nullptr && (pool_starts_ || nested)) {
+        encode_pool();
+    }
+
+    // Set the solutions of the pool that satisfy the fixings as MIP starts
+    if (pool_starts_ && pool_ != nullptr) {
+        add_pool_starts();
+    }
+
+    // Explore large sub-MIPs by the nested heuristic
+    if (nested) {
+        host_nested(start, timer, time_limit, broadcast);
+    }
+
+    // Set sub-MIP abort callback
+    abort_callback_ = submip_->cplex.use(orcs::AbortCallback::create_instance(submip_->env, timer,
+            time_limit, std::numeric_limits<unsigned long long>::max(),
+            submip_nodes_unsuccessful_, submip_->objective.getSense(), target,
+            submip_stall_, broadcast, &preempted_));
+
+    // Optimize the sub-MIP
+    bool found = submip_->cplex.solve();
+    ++num_solved_;
+    status_ = submip_->cplex.getStatus();
+
+    // Get the solution
+    if (found) {
+        objective_ = submip_->cplex.getObjValue();
+        submip_->cplex.getValues(solution_, submip_->variables);
+    }
+
+    // Remove the nested heuristic (the next sub-MIP may be smaller)
+    if (nested) {
+        submip_->cplex.remove(nested_callback_);
+        submip_->cplex.remove(nested_pool_callback_);
+    }
+
+    return found;
+}
+
+void orcs::SubmipSolver::polish(const cxxtimer::Timer* timer, double time_limit) {
+    if (polisher_ != nullptr && status_ != IloAlgorithm::Status::Optimal) {
+        polisher_->polish(solution_, objective_, timer, time_limit);
+    }
+}
+
+void orcs::SubmipSolver::encode_pool() {
+
+    const std::vector<std::size_t>& binaries = binary_variables_;
+    std::size_t nb = binaries.size();
+
+    // Encode the fixings of the binary variables
+    fixed_mask_.reset(nb);
+    fixed_values_.reset(nb);
+    for (std::size_t k = 0; k < nb; ++k) {
+        const IloNumVar& variable = submip_->variables[binaries[k]];
+        if (variable.getUB() - variable.getLB() < THRESHOLD) {
+            fixed_mask_.set(k, true);
+            fixed_values_.set(k, variable.getLB() > 0.5);
+        }
+    }
+
+    // Encode new solutions of the pool (and discard the ones no longer in it)
+    std::unordered_map<unsigned long long, BitVector> encodings;
+    for (const auto& entry : pool_->get_entries()) {
+        auto it = encodings_.find(entry.age);
+        if (it != encodings_.end()) {
+            encodings.emplace(entry.age, std::move(it->second));
+        } else {
+            encodings[entry.age].encode(entry.solution, binaries);
+        }
+    }
+    encodings_.swap(encodings);
+}
+
+void orcs::SubmipSolver::add_pool_starts() {
+
+    // Add the solutions that agree with the fixings (they are feasible for
+    // the sub-MIP, unless it has other constraints, so they are just checked)
+    for (const auto& entry : pool_->get_entries()) {
+        if (encodings_[entry.age].agrees(fixed_values_, fixed_mask_)) {
+            add_start(entry.solution, IloCplex::MIPStartCheckFeas);
+        }
+    }
+}
+
+bool orcs::SubmipSolver::nesting() const {
+    if (nested_ == nullptr || !separable_) {
+        return false;
+    }
+
+    std::size_t count_free = 0;
+    for (std::size_t j = 0; j < (std::size_t) submip_->variables.getSize(); ++j) {
+        if (submip_->variables[j].getUB() - submip_->variables[j].getLB() >= THRESHOLD) {
+            ++count_free;
+        }
+    }
+
+    return (count_free >= recursion_min_size_);
+}
+
+void orcs::SubmipSolver::host_nested(const IloNumArray* start, const cxxtimer::Timer* timer,
+        double time_limit, IncumbentBroadcast* broadcast) {
+
+    // The nested heuristic works on the solutions of the pool that are
+    // feasible for the sub-MIP, the MIP start and the solutions found by the
+    // sub-MIP itself
+    if (nested_pool_ != nullptr) {
+        delete nested_pool_;
+    }
+    nested_pool_ = new SolutionPool(submip_->env, submip_->objective.getSense(),
+            (pool_ != nullptr ? pool_->max_size() : NESTED_POOL_SIZE), true);
+
+    // Solutions of the pool that agree with the fixings of the sub-MIP (both
+    // are encoded over the binary variables in sorted order)
+    if (pool_ != nullptr) {
+        for (const auto& entry : pool_->get_entries()) {
+            auto it = encodings_.find(entry.age);
+            if (it != encodings_.end() && it->second.agrees(fixed_values_, fixed_mask_)) {
+                nested_pool_->add_entry(entry.solution, entry.value);
+            }
+        }
+    }
+
+    if (start != nullptr) {
+        nested_pool_->add_entry(*start, graph().evaluate(*start));
+    }
+
+    nested_pool_callback_ = submip_->cplex.use(orcs::PoolCallback::create_instance(submip_->env,
+            nested_pool_, submip_->variables, broadcast));
+    nested_callback_ = submip_->cplex.use(orcs::HeuristicCallback::create_instance(submip_->env,
+            nested_, nested_pool_, submip_->variables, recursion_frequency_, timer, time_limit,
+            broadcast));
+}
+
+void orcs::SubmipSolver::add_start(const IloNumArray& values, IloCplex::MIPStartEffort effort) {
+    for (std::size_t j = 0; j < (std::size_t) start_values_.getSize(); ++j) {
+        start_values_[j] = values[j];
+    }
+    submip_->cplex.addMIPStart(submip_->variables, start_values_, effort);
+}
+
+bool orcs::SubmipSolver::solve_components(const IloNumArray& reference,
+        const cxxtimer::Timer* timer, double time_limit, bool& found) {
+
+    std::size_t n = submip_->variables.getSize();
+
+    // Identify the free variables of the sub-MIP
+    std::vector<double> lb(n);
+    std::vector<double> ub(n);
+    free_.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        lb[j] = submip_->variables[j].getLB();
+        ub[j] = submip_->variables[j].getUB();
+        free_[j] = (lb[j] < ub[j]);
+    }
+
+    // Find the connected components of the free variables
+    std::size_t num_components = graph().components(free_, component_);
+    if (num_components <= 1) {
+        return false;
+    }
+
+    // Group small components, so that each group has at least a minimum
+    // number of variables (solving tiny sub-MIPs does not pay its setup)
+    std::vector<std::size_t> sizes(num_components, 0);
+    for (std::size_t j = 0; j < n; ++j) {
+        if (component_[j] < n) {
+            ++sizes[component_[j]];
+        }
+    }
+
+    std::vector<std::size_t> order(num_components);
+    for (std::size_t c = 0; c < num_components; ++c) {
+        order[c] = c;
+    }
+    std::sort(order.begin(), order.end(),
+            [&sizes](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+    std::vector<std::size_t> group(num_components);
+    std::size_t num_groups = 0;
+    std::size_t group_size = 0;
+    for (auto c : order) {
+        if (group_size == 0 || group_size >= component_min_size_) {
+            group_size = 0;
+            ++num_groups;
+        }
+        group[c] = num_groups - 1;
+        group_size += sizes[c];
+    }
+
+    if (num_groups <= 1) {
+        return false;
+    }
+
+    // Variables of each group
+    std::vector<std::vector<std::size_t>> members(num_groups);
+    for (std::size_t j = 0; j < n; ++j) {
+        if (component_[j] < n) {
+            component_[j] = group[component_[j]];
+            members[component_[j]].push_back(j);
+        }
+    }
+
+    // Start solution (fixed variables take the value of their bounds)
+    std::vector<double> start(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        start[j] = (free_[j] ? (integer_[j] ? std::round(reference[j]) : reference[j]) : lb[j]);
+    }
+
+    // Solve each group of components
+    std::vector<double> values(start);
+    std::vector<char> group_found(num_groups, 0);
+    std::vector<SubmipStatus> group_status(num_groups, SubmipStatus::UNKNOWN);
+
+    if (workers_.empty()) {
+
+        // Solve the groups one after another in the sub-MIP itself
+        for (std::size_t g = 0; g < num_groups; ++g) {
+
+            // Check timer (stop criterion)
+            if (timer != nullptr && (timer->count<std::chrono::milliseconds>() / 1000.0) >= time_limit) {
+                break;
+            }
+
+            // Unextract previous model in CPLEX solver
+            submip_->cplex.clear();
+
+            // Fix the free variables of other groups (a group covers only part
+            // of the objective function, so it is solved without target and
+            // it neither publishes nor polls the global incumbent)
+            for (std::size_t j = 0; j < n; ++j) {
+                if (free_[j] && component_[j] != g) {
+                    submip_->variables[j].setBounds(start[j], start[j]);
+                }
+            }
+
+            group_found[g] = solve_model(&reference, timer, time_limit,
+                    std::numeric_limits<double>::quiet_NaN(), nullptr);
+            group_status[g] = CplexBackend::convert(status_);
+            if (group_found[g]) {
+                for (auto j : members[g]) {
+                    values[j] = solution_[j];
+                }
+            }
+
+            // Restore the bounds of the free variables of other groups
+            for (std::size_t j = 0; j < n; ++j) {
+                if (free_[j] && component_[j] != g) {
+                    submip_->variables[j].setBounds(lb[j], ub[j]);
+                }
+            }
+        }
+
+    } else {
+
+        // Solve the groups in parallel by the workers
+        std::atomic<std::size_t> next_group(0);
+        std::vector<std::thread> threads;
+        for (std::size_t w = 0; w < workers_.size(); ++w) {
+            threads.emplace_back([&, w]() {
+                SubmipWorker* worker = workers_[w];
+                placement_.pin_worker(w);
+                std::size_t g;
+                while ((g = next_group++) < num_groups) {
+                    group_found[g] = worker->solve(lb, ub, start, component_, g, timer, time_limit);
+                    group_status[g] = worker->status();
+                    if (group_found[g]) {
+                        for (auto j : members[g]) {
+                            values[j] = worker->solution()[j];
+                        }
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        num_solved_ += std::min(next_group.load(), num_groups);
+    }
+
+    // Merge the solutions of the groups (a group without solution keeps the
+    // values of the reference solution, which is feasible for it). If no
+    // group found a solution (e.g., the time limit was reached before), the
+    // reference solution is not a result of the sub-MIP.
+    bool infeasible = false;
+    bool optimal = true;
+    bool any_found = false;
+    for (std::size_t g = 0; g < num_groups; ++g) {
+        infeasible = infeasible || (group_status[g] == SubmipStatus::INFEASIBLE);
+        optimal = optimal && (group_status[g] == SubmipStatus::OPTIMAL);
+        any_found = any_found || group_found[g];
+    }
+
+    if (infeasible) {
+        status_ = IloAlgorithm::Status::Infeasible;
+        found = false;
+    } else if (!any_found) {
+        status_ = IloAlgorithm::Status::Unknown;
+        found = false;
+    } else {
+        status_ = (optimal ? IloAlgorithm::Status::Optimal : IloAlgorithm::Status::Feasible);
+        for (std::size_t j = 0; j < n; ++j) {
+            solution_[j] = values[j];
+        }
+        objective_ = graph().evaluate(solution_);
+        found = true;
+    }
+
+    return true;
+}
@@ -0,0 +1,372 @@
+#ifndef ORCS_SUBMIP_SOLVER_H
+#define ORCS_SUBMIP_SOLVER_H
+
+#include "problem_data.h"
+#include "heuristic.h"
+#include "abort_callback.h"
+#include "constraint_graph.h"
+#include "submip_worker.h"
+#include "placement.h"
+#include "solution_pool.h"
+#include "bit_vector.h"
+#include "continuous_polisher.h"
+#include "parameters.h"
+#include <cstdlib>
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class solves the sub-MIPs built by the heuristics. The heuristic sets
+ * the bounds of the variables of its copy of the problem (the sub-MIP) and
+ * this class extracts, solves and collects the solution of the sub-MIP.
+ *
+ * Optionally, the sub-MIP is split into the connected components of the
+ * variable-constraint graph induced by its free variables. Since these
+ * components do not share any constraint, each one is solved as a smaller
+ * independent sub-MIP (in parallel, if workers are available) and their
+ * solutions are merged. Workers may be pinned to cores by a placement policy,
+ * in which case each worker loads its copy of the problem on its own core, so
+ * that the copy is local to the NUMA node of the worker.
+ *
+ * Optionally, every solution of the pool that agrees with the fixings of the
+ * sub-MIP (checked on bit-packed encodings of their binary variables) is also
+ * given to the sub-MIP as a MIP start.
+ *
+ * After a single (not split) sub-MIP is solved, it remains extracted, then the
+ * heuristic may relax the bounds of some of its variables (widening the
+ * neighborhood) and solve it again, warm started from the previous solution,
+ * without paying the setup of a new sub-MIP.
+ *
+ * Optionally, the sub-MIP exits early, as soon as its incumbent solution
+ * improves the global incumbent solution (set by the heuristic) by a given
+ * margin, instead of spending the rest of its budget on proving optimality.
+ *
+ * Optionally, in mixed problems, the continuous part of a solution of a sub-MIP
+ * not solved to optimality is polished by an LP (with the integer variables
+ * fixed), which is cheaper than spending another sub-MIP on it.
+ *
+ * Optionally, a large sub-MIP hosts a nested heuristic (recursive polishing),
+ * which explores the neighborhood by smaller sub-sub-MIPs from the search tree
+ * of the sub-MIP, instead of letting it time out on its nodes limit.
+ */
+class SubmipSolver {
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param   submip
+     *          Pointer to the copy of the problem used as sub-MIP.
+     * @param   params
+     *          The sub-MIP parameters.
+     */
+    SubmipSolver(ProblemData* submip, const SubmipParameters& params);
+
+    /**
+     * Destructor.
+     */
+    virtual ~SubmipSolver();
+
+    /**
+     * Solve the sub-MIP defined by the current bounds of its variables. The
+     * sub-MIP must have been unextracted (cleared) before setting the bounds.
+     *
+     * @param   reference
+     *          A feasible solution that satisfies the bounds of the sub-MIP,
+     *          used to fix the variables of other components when the sub-MIP
+     *          is split.
+     * @param   start
+     *          A MIP start solution (or nullptr, if there is no one).
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     * @param   time_limit
+     *          The time limit of the optimization process (in seconds).
+     * @param   separable
+     *          It must be set to false if the sub-MIP has constraints that are
+     *          not in the original problem and couple its components (e.g., a
+     *          local branching constraint). In this case, the sub-MIP is never
+     *          split.
+     *
+     * @return  True if a feasible solution was found, false otherwise.
+     */
+    bool solve(const IloNumArray& reference, const IloNumArray* start,
+            const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max(),
+            bool separable = true);
+
+    /**
+     * Return whether the last sub-MIP solved can be solved again after its
+     * bounds are relaxed (i.e., it was solved as a single problem and it is
+     * still extracted).
+     *
+     * @return  True if the sub-MIP can be solved again, false otherwise.
+     */
+    bool resolvable() const;
+
+    /**
+     * Solve again the last sub-MIP solved, after the bounds of some of its
+     * variables have been relaxed (without unextracting it). The solution of
+     * the previous solve, if any, is used as MIP start.
+     *
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     * @param   time_limit
+     *          The time limit of the optimization process (in seconds).
+     *
+     * @return  True if a feasible solution was found, false otherwise.
+     */
+    bool resolve(const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max());
+
+    /**
+     * Set the pool of solutions used as additional MIP starts of sub-MIPs.
+     *
+     * @param   pool
+     *          Pointer to the solution pool.
+     * @param   binary_variables
+     *          Pointer to the indexes of the binary variables of the problem
+     *          (the ones fixed by the heuristic). They are copied (in sorted
+     *          order), so the heuristic may reorder its own vector freely.
+     */
+    void set_pool(const SolutionPool* pool, const std::vector<std::size_t>* binary_variables);
+
+    /**
+     * Set the value of the objective function of the global incumbent solution,
+     * used to exit early from sub-MIPs that have improved it (sub-MIPs split
+     * into components never exit early, since each component covers only part
+     * of the objective function).
+     *
+     * @param   objective
+     *          The value of the objective function of the global incumbent.
+     */
+    void set_incumbent(IloNum objective);
+
+    /**
+     * Set the global incumbent shared with the other searches. Sub-MIPs
+     * publish their incumbent solutions into it and are preempted as soon as
+     * their best bound is dominated by a better solution published by another
+     * search running at the same time. Sub-MIPs split into components neither
+     * publish nor poll it, since each component covers only part of the
+     * objective function.
+     *
+     * @param   broadcast
+     *          Pointer to the global incumbent, or nullptr to disable it.
+     */
+    void set_broadcast(IncumbentBroadcast* broadcast);
+
+    /**
+     * Set the heuristic nested in large sub-MIPs (recursive polishing). While
+     * a sub-MIP with enough free variables is solved, the nested heuristic is
+     * called from its search tree on a pool made of the solutions of the pool
+     * that agree with the fixings of the sub-MIP and the solutions found by the
+     * sub-MIP itself. Sub-MIPs that are not separable (i.e., with constraints
+     * that are not in the original problem) never host the nested heuristic.
+     *
+     * @param   heuristic
+     *          Pointer to the nested heuristic (built on the sub-MIP as its
+     *          problem), or nullptr to disable it.
+     */
+    void set_nested(Heuristic* heuristic);
+
+    /**
+     * Return the status of the last sub-MIP solved.
+     *
+     * @return  The status of the last sub-MIP solved.
+     */
+    IloAlgorithm::Status status() const;
+
+    /**
+     * Return whether the last sub-MIP solved was preempted because its best
+     * bound was dominated by the global incumbent (its status says nothing
+     * about the size of the sub-MIP, then).
+     *
+     * @return  True if the last sub-MIP solved was preempted, false otherwise.
+     */
+    bool preempted() const;
+
+    /**
+     * Return the value of the objective function of the solution found in the
+     * last sub-MIP solved.
+     *
+     * @return  The value of the objective function.
+     */
+    IloNum objective() const;
+
+    /**
+     * Return the solution found in the last sub-MIP solved.
+     *
+     * @return  The values assigned to each variable of the problem.
+     */
+    const IloNumArray& solution() const;
+
+    /**
+     * Return the variable-constraint graph of the sub-MIP (it is built on the
+     * first call).
+     *
+     * @return  The variable-constraint graph of the sub-MIP.
+     */
+    const ConstraintGraph& graph();
+
+    /**
+     * Return the number of sub-MIPs solved so far (each component of a split
+     * sub-MIP and each solve after widening counts as a sub-MIP).
+     *
+     * @return  The number of sub-MIPs solved.
+     */
+    unsigned long long num_solved() const;
+
+    SubmipSolver(const SubmipSolver& other) = delete;
+    SubmipSolver(SubmipSolver&& other) = delete;
+    SubmipSolver& operator=(const SubmipSolver& other) = delete;
+    SubmipSolver& operator=(SubmipSolver&& other) = delete;
+
+private:
+
+    /**
+     * Solve the sub-MIP as a single problem (components of split sub-MIPs
+     * are solved without target and global incumbent).
+     */
+    bool solve_model(const IloNumArray* start, const cxxtimer::Timer* timer,
+            double time_limit, double target = std::numeric_limits<double>::quiet_NaN(),
+            IncumbentBroadcast* broadcast = nullptr);
+
+    /**
+     * Optimize the sub-MIP already extracted.
+     */
+    bool optimize(const IloNumArray* start, const cxxtimer::Timer* timer,
+            double time_limit, double target, IncumbentBroadcast* broadcast);
+
+    /**
+     * Polish the continuous part of the solution of the last sub-MIP, unless
+     * it was solved to optimality.
+     */
+    void polish(const cxxtimer::Timer* timer, double time_limit);
+
+    /**
+     * Encode the binary variables fixed in the sub-MIP and the solutions of
+     * the pool.
+     */
+    void encode_pool();
+
+    /**
+     * Add the solutions of the pool that agree with the binary variables
+     * fixed in the sub-MIP as MIP starts (the pool must be encoded).
+     */
+    void add_pool_starts();
+
+    /**
+     * Return whether the sub-MIP has enough free variables to host the nested
+     * heuristic.
+     */
+    bool nesting() const;
+
+    /**
+     * Set the nested heuristic and the pool it works on as callbacks of the
+     * sub-MIP (the pool must be encoded).
+     */
+    void host_nested(const IloNumArray* start, const cxxtimer::Timer* timer, double time_limit,
+            IncumbentBroadcast* broadcast);
+
+    /**
+     * Add a solution as MIP start. Its values are copied into the environment
+     * of the sub-MIP, which may differ from the one of the solution.
+     */
+    void add_start(const IloNumArray& values,
+            IloCplex::MIPStartEffort effort = IloCplex::MIPStartAuto);
+
+    /**
+     * Solve each group of independent components as a separate sub-MIP. It
+     * returns false, without solving anything, if the sub-MIP has a single
+     * group of components.
+     */
+    bool solve_components(const IloNumArray& reference, const cxxtimer::Timer* timer,
+            double time_limit, bool& found);
+
+    /*
+     * Sub-MIP and result of the last solve.
+     */
+    ProblemData* submip_;
+    IloAlgorithm::Status status_;
+    IloNum objective_;
+    IloNumArray solution_;
+    IloNumArray start_values_;
+    IloNum incumbent_;
+    IncumbentBroadcast* broadcast_;
+    bool preempted_;
+    bool found_;
+    unsigned long long num_solved_;
+
+    /*
+     * Data structures used to solve the last sub-MIP again.
+     */
+    bool resolvable_;
+    double target_;
+    IloCplex::Callback abort_callback_;
+
+    /*
+     * Data structures used to split sub-MIPs into components.
+     */
+    ConstraintGraph* graph_;
+    Placement placement_;
+    std::vector<SubmipWorker*> workers_;
+    std::vector<bool> integer_;
+    std::vector<bool> free_;
+    std::vector<std::size_t> component_;
+
+    /*
+     * Data structures used to add the solutions of the pool as MIP starts
+     * (encodings of the solutions are kept by their age, which identifies
+     * each entry of the pool, and their bits refer to the binary variables in
+     * sorted order).
+     */
+    const SolutionPool* pool_;
+    std::vector<std::size_t> binary_variables_;
+    BitVector fixed_mask_;
+    BitVector fixed_values_;
+    std::unordered_map<unsigned long long, BitVector> encodings_;
+
+    /*
+     * LP used to polish the continuous part of solutions (or nullptr, if
+     * disabled or the problem has no continuous variables).
+     */
+    ContinuousPolisher* polisher_;
+
+    /*
+     * Data structures used to host the nested heuristic in large sub-MIPs.
+     */
+    Heuristic* nested_;
+    SolutionPool* nested_pool_;
+    bool separable_;
+    IloCplex::Callback nested_callback_;
+    IloCplex::Callback nested_pool_callback_;
+
+    /*
+     * Parameters.
+     */
+    long submip_nodes_unsuccessful_;
+    bool pool_starts_;
+    StallCriterion submip_stall_;
+    double early_exit_margin_;
+    bool split_components_;
+    std::size_t component_min_size_;
+    std::size_t recursion_min_size_;
+    unsigned long long recursion_frequency_;
+
+    static constexpr double THRESHOLD = 1e-5;
+    static constexpr std::size_t NESTED_POOL_SIZE = 10;
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+#include "submip_worker.h"
+
+
+orcs::SubmipWorker::SubmipWorker(const std::string& filename, const ConstraintGraph& graph,
+        const SubmipParameters& params) :
+        small_backend_(nullptr), large_backend_(nullptr), last_backend_(nullptr)
+{
+    // Parameters
+    const std::string& backend = params.backend;
+    backend_threshold_ = params.backend_threshold;
+
+    // Create the backends
+    if (backend == "auto") {
+        large_backend_ = SubmipBackend::create("cplex", filename, graph, params);
+        try {
+            small_backend_ = SubmipBackend::create("highs", filename, graph, params);
+        } catch (...) {
+            delete large_backend_;
+            throw;
+        }
+    } else {
+        large_backend_ = SubmipBackend::create(backend, filename, graph, params);
+        small_backend_ = large_backend_;
+    }
+}
+
+orcs::SubmipWorker::~SubmipWorker() {
+    if (small_backend_ != large_backend_) {
+        delete small_backend_;
+    }
+    delete large_backend_;
+}
+
+bool orcs::SubmipWorker::solve(const std::vector<double>& lb, const std::vector<double>& ub,
+        const std::vector<double>& start, const std::vector<std::size_t>& component,
+        std::size_t target, const cxxtimer::Timer* timer, double time_limit) {
+
+    // Choose the backend by the number of free variables of the sub-MIP
+    std::size_t num_free = 0;
+    for (std::size_t j = 0; j < lb.size(); ++j) {
+        num_free += (component[j] == target && lb[j] < ub[j]);
+    }
+    last_backend_ = (num_free <= backend_threshold_ ? small_backend_ : large_backend_);
+
+    // Free the variables of the component and fix the others
+    for (std::size_t j = 0; j < lb.size(); ++j) {
+        if (component[j] == target || component[j] == lb.size()) {
+            last_backend_->set_bounds(j, lb[j], ub[j]);
+        } else {
+            last_backend_->set_bounds(j, start[j], start[j]);
+        }
+    }
+
+    // Set a MIP start solution and optimize the sub-MIP
+    last_backend_->set_start(start);
+    return last_backend_->solve(timer, time_limit);
+}
+
+orcs::SubmipStatus orcs::SubmipWorker::status() const {
+    return (last_backend_ != nullptr ? last_backend_->status() : SubmipStatus::UNKNOWN);
+}
+
+double orcs::SubmipWorker::objective() const {
+    return last_backend_->objective();
+}
+
+const std::vector<double>& orcs::SubmipWorker::solution() const {
+    return last_backend_->solution();
+}
@@ -0,0 +1,123 @@
+#ifndef ORCS_SUBMIP_WORKER_H
+#define ORCS_SUBMIP_WORKER_H
+
+#include "constraint_graph.h"
+#include "submip_backend.h"
+#include "parameters.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <limits>
+#include <ilcplex/ilocplex.h>
+#include <cxxtimer.hpp>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * A worker able to solve sub-MIPs in its own thread. Each worker keeps its own
+ * backends (MIP solvers), each with its own copy of the problem. Data are
+ * exchanged with the worker through plain vectors indexed by the variables of
+ * the problem. The backend used to solve a sub-MIP may depend on its size: with
+ * the "auto" backend, sub-MIPs with few free variables are solved by HiGHS and
+ * the others by CPLEX.
+ */
+class SubmipWorker {
+
+public:
+
+    /**
+     * Constructor. It creates its backends, which load their own copies of
+     * the problem.
+     *
+     * @param   filename
+     *          Path to file containing the optimization problem.
+     * @param   graph
+     *          The variable-constraint graph of the problem.
+     * @param   params
+     *          The sub-MIP parameters.
+     */
+    SubmipWorker(const std::string& filename, const ConstraintGraph& graph,
+            const SubmipParameters& params);
+
+    /**
+     * Destructor.
+     */
+    virtual ~SubmipWorker();
+
+    /**
+     * Solve a sub-MIP in which only the variables of a given component are
+     * free. Variables not fixed by the bounds, but outside the component, are
+     * fixed to their values in the start solution.
+     *
+     * @param   lb
+     *          Lower bounds of the variables in the sub-MIP.
+     * @param   ub
+     *          Upper bounds of the variables in the sub-MIP.
+     * @param   start
+     *          A solution that satisfies the bounds, used as MIP start.
+     * @param   component
+     *          The component of each variable.
+     * @param   target
+     *          The component to optimize.
+     * @param   timer
+     *          The timer to get the elapsed time spent on the entire
+     *          optimization process.
+     * @param   time_limit
+     *          The time limit of the optimization process (in seconds).
+     *
+     * @return  True if a feasible solution was found, false otherwise.
+     */
+    bool solve(const std::vector<double>& lb, const std::vector<double>& ub,
+            const std::vector<double>& start, const std::vector<std::size_t>& component,
+            std::size_t target, const cxxtimer::Timer* timer = nullptr,
+            double time_limit = std::numeric_limits<double>::max());
+
+    /**
+     * Return the status of the last sub-MIP solved.
+     *
+     * @return  The status of the last sub-MIP solved.
+     */
+    SubmipStatus status() const;
+
+    /**
+     * Return the value of the objective function of the solution found in the
+     * last sub-MIP solved.
+     *
+     * @return  The value of the objective function.
+     */
+    double objective() const;
+
+    /**
+     * Return the solution found in the last sub-MIP solved.
+     *
+     * @return  The values assigned to each variable of the problem.
+     */
+    const std::vector<double>& solution() const;
+
+    SubmipWorker(const SubmipWorker& other) = delete;
+    SubmipWorker(SubmipWorker&& other) = delete;
+    SubmipWorker& operator=(const SubmipWorker& other) = delete;
+    SubmipWorker& operator=(SubmipWorker&& other) = delete;
+
+private:
+
+    /*
+     * Backends used to solve small and large sub-MIPs (they may be the same),
+     * and the backend used in the last sub-MIP solved.
+     */
+    SubmipBackend* small_backend_;
+    SubmipBackend* large_backend_;
+    SubmipBackend* last_backend_;
+
+    /*
+     * Parameters.
+     */
+    std::size_t backend_threshold_;
+};
+
+}
+
+#endif
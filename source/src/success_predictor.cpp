@@ -0,0 +1,144 @@
+#include "success_predictor.h"
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+
+
+orcs::SuccessPredictor::SuccessPredictor(const PredictorParameters& params) :
+        num_samples_(0), rejected_in_row_(0), num_rejected_(0), params_(params)
+{
+    weights_.fill(0.0);
+    recent_success_.fill(0.5);
+}
+
+bool orcs::SuccessPredictor::enabled() const {
+    return params_.threshold > 0.0;
+}
+
+orcs::SuccessPredictor::Features orcs::SuccessPredictor::describe(const ProblemData& submip,
+        const std::vector<std::size_t>& binary_variables, const IloNumArray& seed,
+        double seed_value, double incumbent_value, const SolutionPool& pool,
+        ValueSpan relaxation, Operator op) const {
+
+    Features features;
+    features.op = op;
+    features.seed_gap = std::min(1.0, std::abs(seed_value - incumbent_value) /
+            (THRESHOLD + std::abs(incumbent_value)));
+
+    // Agreement of the pool and distance to the relaxation on the free
+    // binary variables
+    std::size_t count_free = 0;
+    double agreement = 0.0;
+    double distance = 0.0;
+    for (auto idx : binary_variables) {
+        if (submip.variables[idx].getUB() - submip.variables[idx].getLB() < THRESHOLD) {
+            continue;
+        }
+
+        ++count_free;
+        double value = (seed[idx] > 0.5 ? 1.0 : 0.0);
+        if (pool.size() > 0) {
+            std::size_t count_equal = 0;
+            for (const auto& entry : pool.get_entries()) {
+                count_equal += (std::abs(entry.solution[idx] - value) < 0.5);
+            }
+            agreement += count_equal / (double) pool.size();
+        }
+
+        if (!relaxation.empty()) {
+            distance += std::abs(value - relaxation[idx]);
+        }
+    }
+
+    if (count_free > 0) {
+        features.pool_agreement = agreement / count_free;
+        features.relaxation_distance = distance / count_free;
+    }
+
+    features.free_fraction = (binary_variables.empty() ? 0.0 :
+            count_free / (double) binary_variables.size());
+
+    return features;
+}
+
+std::array<double, orcs::SuccessPredictor::NUM_FEATURES> orcs::SuccessPredictor::encode(
+        const Features& features) const {
+    std::size_t op = static_cast<std::size_t>(features.op);
+
+    std::array<double, NUM_FEATURES> x;
+    x.fill(0.0);
+    x[0] = 1.0;
+    x[1] = features.free_fraction;
+    x[2] = features.pool_agreement;
+    x[3] = features.relaxation_distance;
+    x[4] = features.seed_gap;
+    x[5] = recent_success_[op];
+    x[6 + op] = 1.0;
+    return x;
+}
+
+double orcs::SuccessPredictor::predict(const Features& features) const {
+    std::array<double, NUM_FEATURES> x = encode(features);
+    double z = 0.0;
+    for (std::size_t k = 0; k < NUM_FEATURES; ++k) {
+        z += weights_[k] * x[k];
+    }
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+bool orcs::SuccessPredictor::accept(const Features& features, std::mt19937& random) {
+
+    // Accept every neighborhood during the warmup, the ones explored and the
+    // ones that exceed the limit of rejections in a row
+    bool accepted = (!enabled() || num_samples_ < (unsigned long long) params_.warmup ||
+            rejected_in_row_ >= params_.resamples ||
+            std::uniform_real_distribution<double>(0.0, 1.0)(random) < params_.exploration ||
+            predict(features) >= params_.threshold);
+
+    if (accepted) {
+        rejected_in_row_ = 0;
+    } else {
+        ++rejected_in_row_;
+        ++num_rejected_;
+    }
+
+    return accepted;
+}
+
+void orcs::SuccessPredictor::update(const Features& features, bool success) {
+    std::array<double, NUM_FEATURES> x = encode(features);
+    double error = (success ? 1.0 : 0.0) - predict(features);
+    for (std::size_t k = 0; k < NUM_FEATURES; ++k) {
+        weights_[k] += params_.learning_rate * (error * x[k] - REGULARIZATION * weights_[k]);
+    }
+
+    std::size_t op = static_cast<std::size_t>(features.op);
+    recent_success_[op] += RECENT_DECAY * ((success ? 1.0 : 0.0) - recent_success_[op]);
+    ++num_samples_;
+}
+
+unsigned long long orcs::SuccessPredictor::num_rejected() const {
+    return num_rejected_;
+}
+
+void orcs::SuccessPredictor::write_state(std::ostream& output) const {
+    output << std::setprecision(17);
+    for (auto weight : weights_) {
+        output << weight << " ";
+    }
+    for (auto recent : recent_success_) {
+        output << recent << " ";
+    }
+    output << num_samples_ << " " << num_rejected_ << "\n";
+}
+
+void orcs::SuccessPredictor::read_state(std::istream& input) {
+    for (auto& weight : weights_) {
+        input >> weight;
+    }
+    for (auto& recent : recent_success_) {
+        input >> recent;
+    }
+    input >> num_samples_ >> num_rejected_;
+    rejected_in_row_ = 0;
+}
@@ -0,0 +1,193 @@
+#ifndef ORCS_SUCCESS_PREDICTOR_H
+#define ORCS_SUCCESS_PREDICTOR_H
+
+#include "problem_data.h"
+#include "solution_pool.h"
+#include "heuristic_context.h"
+#include "parameters.h"
+#include <cstdlib>
+#include <array>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class predicts the probability that a neighborhood (a sub-MIP built by
+ * a heuristic) succeeds, i.e., that it finds a solution better than the one
+ * it was built around. The prediction is made from cheap features of the
+ * neighborhood, computed before any call to the solver, by a logistic
+ * regression trained online (a step of stochastic gradient descent after each
+ * sub-MIP solved), so the history of which neighborhoods succeeded is kept
+ * along the search.
+ *
+ * Neighborhoods with a predicted probability below a threshold are rejected,
+ * so the heuristic resamples them instead of solving them. The predictor only
+ * rejects neighborhoods after a warmup, accepts some of them regardless of
+ * the prediction (so it keeps learning about all kinds of neighborhoods) and
+ * never rejects more than a given number of neighborhoods in a row.
+ */
+class SuccessPredictor {
+
+public:
+
+    /**
+     * Operators that build neighborhoods (the operator is a feature).
+     */
+    enum class Operator { FIXING, LOCAL_BRANCHING, RECOMBINATION };
+
+    /**
+     * Features of a neighborhood: the fraction of binary variables it keeps
+     * free, the average agreement of the pool with the seed solution on the
+     * free variables, the average distance of the seed solution to the
+     * relaxation on the free variables, the relative gap of the seed solution
+     * to the incumbent and the operator that built it.
+     */
+    struct Features {
+        double free_fraction = 0.0;
+        double pool_agreement = 0.0;
+        double relaxation_distance = 0.0;
+        double seed_gap = 0.0;
+        Operator op = Operator::FIXING;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param   params
+     *          The parameters of the predictor.
+     */
+    explicit SuccessPredictor(const PredictorParameters& params);
+
+    /**
+     * Return whether the predictor is enabled.
+     *
+     * @return  True if neighborhoods may be rejected, false otherwise.
+     */
+    bool enabled() const;
+
+    /**
+     * Compute the features of a neighborhood from the bounds of the binary
+     * variables of its sub-MIP (the free ones are the ones not fixed).
+     *
+     * @param   submip
+     *          The sub-MIP of the neighborhood.
+     * @param   binary_variables
+     *          Indexes of the binary variables of the problem.
+     * @param   seed
+     *          The solution the neighborhood was built around.
+     * @param   seed_value
+     *          The value of the objective function of the seed solution.
+     * @param   incumbent_value
+     *          The value of the objective function of the incumbent solution.
+     * @param   pool
+     *          The pool of solutions.
+     * @param   relaxation
+     *          The solution of the relaxation (or an empty view).
+     * @param   op
+     *          The operator that built the neighborhood.
+     *
+     * @return  The features of the neighborhood.
+     */
+    Features describe(const ProblemData& submip, const std::vector<std::size_t>& binary_variables,
+            const IloNumArray& seed, double seed_value, double incumbent_value,
+            const SolutionPool& pool, ValueSpan relaxation, Operator op) const;
+
+    /**
+     * Estimate the probability of success of a neighborhood.
+     *
+     * @param   features
+     *          The features of the neighborhood.
+     *
+     * @return  The probability of success.
+     */
+    double predict(const Features& features) const;
+
+    /**
+     * Decide whether a neighborhood is solved or resampled.
+     *
+     * @param   features
+     *          The features of the neighborhood.
+     * @param   random
+     *          The random number generator of the heuristic.
+     *
+     * @return  True if the neighborhood must be solved, false if it must be
+     *          resampled.
+     */
+    bool accept(const Features& features, std::mt19937& random);
+
+    /**
+     * Train the model with the outcome of a neighborhood solved.
+     *
+     * @param   features
+     *          The features of the neighborhood.
+     * @param   success
+     *          Whether the neighborhood succeeded.
+     */
+    void update(const Features& features, bool success);
+
+    /**
+     * Return the number of neighborhoods rejected so far.
+     *
+     * @return  The number of neighborhoods rejected.
+     */
+    unsigned long long num_rejected() const;
+
+    /**
+     * Write the model (weights, recent success of each operator and counters).
+     *
+     * @param   output
+     *          The stream to write the model.
+     */
+    void write_state(std::ostream& output) const;
+
+    /**
+     * Restore the model written by write_state.
+     *
+     * @param   input
+     *          The stream to read the model.
+     */
+    void read_state(std::istream& input);
+
+private:
+
+    static constexpr std::size_t NUM_OPERATORS = 3;
+    static constexpr std::size_t NUM_FEATURES = 6 + NUM_OPERATORS;
+
+    /**
+     * Encode the features of a neighborhood as the input of the model.
+     */
+    std::array<double, NUM_FEATURES> encode(const Features& features) const;
+
+    /*
+     * Model (weights of the logistic regression) and exponential moving
+     * averages of the success of each operator (a feature).
+     */
+    std::array<double, NUM_FEATURES> weights_;
+    std::array<double, NUM_OPERATORS> recent_success_;
+
+    /*
+     * Counters of neighborhoods solved, rejected in a row and rejected.
+     */
+    unsigned long long num_samples_;
+    long rejected_in_row_;
+    unsigned long long num_rejected_;
+
+    /*
+     * Parameters.
+     */
+    PredictorParameters params_;
+
+    static constexpr double THRESHOLD = 1e-5;
+    static constexpr double RECENT_DECAY = 0.1;
+    static constexpr double REGULARIZATION = 1e-4;
+};
+
+}
+
+#endif
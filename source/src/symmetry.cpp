@@ -0,0 +1,409 @@
+#include "symmetry.h"
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_set>
+
+
+namespace {
+
+/*
+ * Mix the bits of a 64-bit value (finalizer of SplitMix64).
+ */
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * Hash of the bits of a double (exactly equal values have equal hashes).
+ */
+std::uint64_t hash_double(double value) {
+    if (value == 0.0) {
+        value = 0.0;
+    }
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mix(bits);
+}
+
+/*
+ * Hash of a value of a variable (values closer than the resolution are
+ * usually mapped onto the same hash).
+ */
+std::uint64_t hash_value(double value, double resolution) {
+    return mix(static_cast<std::uint64_t>(std::llround(value / resolution)));
+}
+
+/*
+ * Hash of a variable taking a value.
+ */
+std::uint64_t hash_assignment(std::size_t variable, std::uint64_t value) {
+    return mix(mix(static_cast<std::uint64_t>(variable)) ^ value);
+}
+
+/*
+ * Root of the set of an element (union-find with path halving).
+ */
+std::size_t find_root(std::vector<std::size_t>& parent, std::size_t element) {
+    while (parent[element] != element) {
+        parent[element] = parent[parent[element]];
+        element = parent[element];
+    }
+    return element;
+}
+
+/*
+ * Number of distinct colors in a vector of colors.
+ */
+std::size_t count_colors(const std::vector<std::uint64_t>& colors) {
+    std::unordered_set<std::uint64_t> distinct(colors.begin(), colors.end());
+    return distinct.size();
+}
+
+}
+
+
+orcs::Symmetry::Symmetry(const ProblemData& problem) : graph_(problem), num_cells_(0),
+        work_(0), graph_size_(0) {
+
+    std::size_t n = graph_.num_variables();
+    std::size_t m = graph_.num_constraints();
+
+    // Initial colors of variables (type, bounds and objective coefficient)
+    variable_colors_.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        const IloNumVar& variable = problem.variables[j];
+        std::uint64_t color = mix(static_cast<std::uint64_t>(variable.getType()));
+        color = mix(color ^ hash_double(variable.getLB()));
+        color = mix(color ^ hash_double(variable.getUB()));
+        color = mix(color ^ hash_double(graph_.objective_coef(j)));
+        variable_colors_[j] = color;
+    }
+
+    // Initial colors of constraints (bounds)
+    row_colors_.resize(m);
+    for (std::size_t i = 0; i < m; ++i) {
+        row_colors_[i] = mix(hash_double(graph_.row_lb(i)) ^ mix(hash_double(graph_.row_ub(i))));
+    }
+
+    // Size of the graph (work of each refinement round)
+    graph_size_ = n + m;
+    for (std::size_t i = 0; i < m; ++i) {
+        graph_size_ += 2 * graph_.row_size(i);
+    }
+
+    // Stable partition of the formulation
+    num_cells_ = refine(variable_colors_, row_colors_);
+
+    // Generators of the symmetry group (only if the stable partition has a
+    // cell with more than one variable)
+    if (num_cells_ < n) {
+        for (std::size_t i = 0; i < m; ++i) {
+            rows_by_key_.emplace(row_key(i, nullptr), i);
+        }
+
+        marked_.assign(n, false);
+        marked_coefs_.assign(n, 0.0);
+        find_generators();
+    }
+}
+
+bool orcs::Symmetry::detected() const {
+    return !generators_.empty();
+}
+
+std::size_t orcs::Symmetry::num_cells() const {
+    return num_cells_;
+}
+
+std::size_t orcs::Symmetry::num_generators() const {
+    return generators_.size();
+}
+
+std::uint64_t orcs::Symmetry::hash(const IloNumArray& solution) const {
+    std::uint64_t hash = 0;
+    for (std::size_t j = 0; j < graph_.num_variables(); ++j) {
+        hash += hash_assignment(j, hash_value(solution[j], RESOLUTION));
+    }
+
+    return hash;
+}
+
+std::uint64_t orcs::Symmetry::image_hash(const IloNumArray& solution, std::size_t generator,
+        bool inverse) const {
+
+    // The image y of x is y[g[j]] = x[j] (or y[j] = x[g[j]] by the inverse)
+    const std::vector<std::size_t>& permutation = generators_[generator];
+    std::uint64_t hash = 0;
+    for (std::size_t j = 0; j < graph_.num_variables(); ++j) {
+        if (inverse) {
+            hash += hash_assignment(j, hash_value(solution[permutation[j]], RESOLUTION));
+        } else {
+            hash += hash_assignment(permutation[j], hash_value(solution[j], RESOLUTION));
+        }
+    }
+
+    return hash;
+}
+
+bool orcs::Symmetry::is_image(const IloNumArray& solution, const IloNumArray& image,
+        std::size_t generator, bool inverse) const {
+
+    const std::vector<std::size_t>& permutation = generators_[generator];
+    for (std::size_t j = 0; j < graph_.num_variables(); ++j) {
+        double difference = (inverse ? image[j] - solution[permutation[j]] :
+                image[permutation[j]] - solution[j]);
+        if (std::abs(difference) > RESOLUTION) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void orcs::Symmetry::find_generators() {
+
+    std::size_t n = graph_.num_variables();
+
+    // Cells of the stable partition (in order of their first variables)
+    std::unordered_map<std::uint64_t, std::size_t> cell_index;
+    std::vector<std::vector<std::size_t>> cells;
+    for (std::size_t j = 0; j < n; ++j) {
+        auto it = cell_index.find(variable_colors_[j]);
+        if (it == cell_index.end()) {
+            it = cell_index.emplace(variable_colors_[j], cells.size()).first;
+            cells.emplace_back();
+        }
+        cells[it->second].push_back(j);
+    }
+
+    // Orbits of the group generated by the generators found so far
+    std::vector<std::size_t> orbit(n);
+    std::iota(orbit.begin(), orbit.end(), 0);
+
+    // Try to map the first variable of each cell onto the other ones
+    std::vector<std::size_t> permutation;
+    for (const auto& cell : cells) {
+        for (std::size_t k = 1; k < cell.size(); ++k) {
+
+            if (generators_.size() >= MAX_GENERATORS || work_ > WORK_LIMIT) {
+                return;
+            }
+
+            if (find_root(orbit, cell[0]) == find_root(orbit, cell[k])) {
+                continue;
+            }
+
+            if (find_automorphism(cell[0], cell[k], permutation)) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    std::size_t root = find_root(orbit, j);
+                    orbit[root] = find_root(orbit, permutation[j]);
+                }
+                generators_.push_back(permutation);
+            }
+        }
+    }
+}
+
+bool orcs::Symmetry::find_automorphism(std::size_t from, std::size_t to,
+        std::vector<std::size_t>& permutation) {
+
+    std::size_t n = graph_.num_variables();
+
+    left_variable_colors_ = variable_colors_;
+    left_row_colors_ = row_colors_;
+    right_variable_colors_ = variable_colors_;
+    right_row_colors_ = row_colors_;
+
+    std::unordered_map<std::uint64_t, std::size_t> count;
+    std::unordered_map<std::uint64_t, std::size_t> index;
+
+    for (std::uint64_t depth = 1; work_ <= WORK_LIMIT; ++depth) {
+
+        // Individualize a variable in each coloring (by the same color) and
+        // refine both of them alike
+        std::uint64_t individual = mix(depth);
+        left_variable_colors_[from] = mix(left_variable_colors_[from] ^ individual);
+        right_variable_colors_[to] = mix(right_variable_colors_[to] ^ individual);
+        if (refine(left_variable_colors_, left_row_colors_) !=
+                refine(right_variable_colors_, right_row_colors_)) {
+            return false;
+        }
+
+        // Find the first variable of a cell with more than one variable
+        count.clear();
+        for (std::size_t j = 0; j < n; ++j) {
+            ++count[left_variable_colors_[j]];
+        }
+
+        from = n;
+        for (std::size_t j = 0; j < n && from == n; ++j) {
+            if (count[left_variable_colors_[j]] > 1) {
+                from = j;
+            }
+        }
+
+        // Both colorings are discrete: the permutation maps each variable
+        // onto the one with the same color
+        if (from == n) {
+            index.clear();
+            for (std::size_t j = 0; j < n; ++j) {
+                index[right_variable_colors_[j]] = j;
+            }
+
+            permutation.resize(n);
+            for (std::size_t j = 0; j < n; ++j) {
+                auto it = index.find(left_variable_colors_[j]);
+                if (it == index.end()) {
+                    return false;
+                }
+                permutation[j] = it->second;
+            }
+
+            return is_automorphism(permutation);
+        }
+
+        // Otherwise, individualize the first variable of the same color in
+        // the other coloring (without backtracking)
+        to = n;
+        for (std::size_t j = 0; j < n && to == n; ++j) {
+            if (right_variable_colors_[j] == left_variable_colors_[from]) {
+                to = j;
+            }
+        }
+
+        if (to == n) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool orcs::Symmetry::is_automorphism(const std::vector<std::size_t>& permutation) {
+
+    // Bounds, types and objective coefficients of the variables
+    for (std::size_t j = 0; j < graph_.num_variables(); ++j) {
+        std::size_t k = permutation[j];
+        if (graph_.column_lb(j) != graph_.column_lb(k) ||
+                graph_.column_ub(j) != graph_.column_ub(k) ||
+                graph_.column_integer(j) != graph_.column_integer(k) ||
+                graph_.objective_coef(j) != graph_.objective_coef(k)) {
+            return false;
+        }
+    }
+
+    // Each constraint must be mapped onto a constraint with the same bounds
+    // and coefficients
+    for (std::size_t i = 0; i < graph_.num_constraints(); ++i) {
+        const std::size_t* variables = graph_.row_variables(i);
+        const double* coefs = graph_.row_coefs(i);
+
+        bool mapped = false;
+        auto range = rows_by_key_.equal_range(row_key(i, &permutation));
+        for (auto it = range.first; it != range.second && !mapped; ++it) {
+            std::size_t row = it->second;
+            if (graph_.row_size(row) != graph_.row_size(i) ||
+                    graph_.row_lb(row) != graph_.row_lb(i) ||
+                    graph_.row_ub(row) != graph_.row_ub(i)) {
+                continue;
+            }
+
+            const std::size_t* row_variables = graph_.row_variables(row);
+            const double* row_coefs = graph_.row_coefs(row);
+            for (std::size_t k = 0; k < graph_.row_size(row); ++k) {
+                marked_[row_variables[k]] = true;
+                marked_coefs_[row_variables[k]] = row_coefs[k];
+            }
+
+            mapped = true;
+            for (std::size_t k = 0; k < graph_.row_size(i) && mapped; ++k) {
+                std::size_t image = permutation[variables[k]];
+                mapped = (marked_[image] && marked_coefs_[image] == coefs[k]);
+            }
+
+            for (std::size_t k = 0; k < graph_.row_size(row); ++k) {
+                marked_[row_variables[k]] = false;
+            }
+        }
+
+        if (!mapped) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::uint64_t orcs::Symmetry::row_key(std::size_t row,
+        const std::vector<std::size_t>* permutation) const {
+
+    const std::size_t* variables = graph_.row_variables(row);
+    const double* coefs = graph_.row_coefs(row);
+
+    std::uint64_t key = 0;
+    for (std::size_t k = 0; k < graph_.row_size(row); ++k) {
+        std::size_t variable = (permutation != nullptr ? (*permutation)[variables[k]] : variables[k]);
+        key += hash_assignment(variable, hash_double(coefs[k]));
+    }
+
+    return mix(key ^ mix(hash_double(graph_.row_lb(row)) ^ mix(hash_double(graph_.row_ub(row)))));
+}
+
+std::size_t orcs::Symmetry::refine(std::vector<std::uint64_t>& variable_colors,
+        std::vector<std::uint64_t>& row_colors) {
+
+    std::size_t n = graph_.num_variables();
+    std::size_t m = graph_.num_constraints();
+
+    std::size_t num_colors = count_colors(variable_colors) + count_colors(row_colors);
+    std::size_t num_variable_colors = 0;
+
+    for (std::size_t round = 0; round < MAX_ROUNDS; ++round) {
+
+        work_ += graph_size_;
+
+        // Refine the colors of the constraints by the (multiset of) colors of
+        // their variables and coefficients
+        next_colors_.resize(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            const std::size_t* variables = graph_.row_variables(i);
+            const double* coefs = graph_.row_coefs(i);
+            std::uint64_t neighborhood = 0;
+            for (std::size_t k = 0; k < graph_.row_size(i); ++k) {
+                neighborhood += mix(hash_double(coefs[k]) ^ variable_colors[variables[k]]);
+            }
+            next_colors_[i] = mix(row_colors[i] ^ mix(neighborhood));
+        }
+        row_colors.swap(next_colors_);
+
+        // Refine the colors of the variables by the (multiset of) colors of
+        // their constraints and coefficients
+        next_colors_.resize(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            const std::size_t* constraints = graph_.column_constraints(j);
+            const double* coefs = graph_.column_coefs(j);
+            std::uint64_t neighborhood = 0;
+            for (std::size_t k = 0; k < graph_.column_size(j); ++k) {
+                neighborhood += mix(hash_double(coefs[k]) ^ row_colors[constraints[k]]);
+            }
+            next_colors_[j] = mix(variable_colors[j] ^ mix(neighborhood));
+        }
+        variable_colors.swap(next_colors_);
+
+        // Stop when the partition is stable
+        num_variable_colors = count_colors(variable_colors);
+        std::size_t next_num_colors = num_variable_colors + count_colors(row_colors);
+        if (next_num_colors == num_colors) {
+            break;
+        }
+
+        num_colors = next_num_colors;
+    }
+
+    return num_variable_colors;
+}
@@ -0,0 +1,212 @@
+#ifndef ORCS_SYMMETRY_H
+#define ORCS_SYMMETRY_H
+
+#include "problem_data.h"
+#include "constraint_graph.h"
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <ilcplex/ilocplex.h>
+
+ILOSTLBEGIN
+
+
+namespace orcs {
+
+/**
+ * This class detects formulation symmetry of a problem: permutations of the
+ * variables that map the formulation (bounds and types of the variables,
+ * objective function and constraints) onto itself.
+ *
+ * The variables are first partitioned by color refinement (1-dimensional
+ * Weisfeiler-Leman) on the variable-constraint graph, with vertices colored by
+ * variable types, bounds and objective coefficients, constraint bounds, and
+ * edges colored by the coefficients of the constraint matrix. Every
+ * automorphism of the formulation maps each cell of the resulting stable
+ * partition onto itself. Generators of the symmetry group are then searched by
+ * individualization-refinement: a variable of a cell is individualized in a
+ * copy of the stable partition and another variable of the same cell in
+ * another copy, both are refined alike, and so on until both partitions are
+ * discrete, which gives a candidate permutation. Each candidate is checked
+ * against the formulation and kept only if it is an automorphism. The search
+ * follows a single path (without backtracking) and is limited by a budget of
+ * work, so some generators may be missed, but every generator found is an
+ * exact symmetry of the formulation.
+ */
+class Symmetry {
+
+public:
+
+    /**
+     * Constructor. It detects the formulation symmetry of a problem.
+     *
+     * @param   problem
+     *          Problem data.
+     */
+    explicit Symmetry(const ProblemData& problem);
+
+    /**
+     * Return whether some symmetry of the formulation was found (i.e., if at
+     * least one generator was found).
+     *
+     * @return  True if some symmetry was detected, false otherwise.
+     */
+    bool detected() const;
+
+    /**
+     * Return the number of cells of the stable partition of the variables (an
+     * upper bound on the number of orbits of the symmetry group).
+     *
+     * @return  The number of cells of the stable partition of the variables.
+     */
+    std::size_t num_cells() const;
+
+    /**
+     * Return the number of generators of the symmetry group found.
+     *
+     * @return  The number of generators found.
+     */
+    std::size_t num_generators() const;
+
+    /**
+     * Compute a hash of the values of a solution (solutions with equal values,
+     * up to the resolution, have the same hash).
+     *
+     * @param   solution
+     *          Values assigned to each variable of the problem.
+     *
+     * @return  The hash of the solution.
+     */
+    std::uint64_t hash(const IloNumArray& solution) const;
+
+    /**
+     * Compute the hash of the image of a solution under a generator (or its
+     * inverse), without building the image. It is equal to the hash of the
+     * image.
+     *
+     * @param   solution
+     *          Values assigned to each variable of the problem.
+     * @param   generator
+     *          Index of the generator.
+     * @param   inverse
+     *          If true, the inverse of the generator is applied.
+     *
+     * @return  The hash of the image of the solution.
+     */
+    std::uint64_t image_hash(const IloNumArray& solution, std::size_t generator,
+            bool inverse) const;
+
+    /**
+     * Check whether a solution is the image of another one under a generator
+     * (or its inverse), up to the resolution.
+     *
+     * @param   solution
+     *          Values assigned to each variable of the problem.
+     * @param   image
+     *          Values assigned to each variable of the problem.
+     * @param   generator
+     *          Index of the generator.
+     * @param   inverse
+     *          If true, the inverse of the generator is applied.
+     *
+     * @return  True if the generator (or its inverse) maps the solution onto
+     *          the image, false otherwise.
+     */
+    bool is_image(const IloNumArray& solution, const IloNumArray& image,
+            std::size_t generator, bool inverse) const;
+
+private:
+
+    /**
+     * Refine the colors of variables and constraints until they are stable.
+     * It returns the number of distinct colors of variables.
+     */
+    std::size_t refine(std::vector<std::uint64_t>& variable_colors,
+            std::vector<std::uint64_t>& row_colors);
+
+    /**
+     * Search generators of the symmetry group (by individualization-refinement
+     * on the stable partition), skipping variables already known to be in the
+     * same orbit.
+     */
+    void find_generators();
+
+    /**
+     * Search an automorphism that maps a variable onto another one of the same
+     * cell by following a single path of individualization-refinement. It
+     * returns false if the path fails, the budget of work is exhausted or the
+     * candidate permutation is not an automorphism.
+     */
+    bool find_automorphism(std::size_t from, std::size_t to,
+            std::vector<std::size_t>& permutation);
+
+    /**
+     * Check whether a permutation of the variables maps the formulation onto
+     * itself.
+     */
+    bool is_automorphism(const std::vector<std::size_t>& permutation);
+
+    /**
+     * Hash of the bounds and the (permuted) coefficients of a constraint.
+     */
+    std::uint64_t row_key(std::size_t row, const std::vector<std::size_t>* permutation) const;
+
+    ConstraintGraph graph_;
+
+    /*
+     * Stable colors of the formulation.
+     */
+    std::vector<std::uint64_t> variable_colors_;
+    std::vector<std::uint64_t> row_colors_;
+    std::size_t num_cells_;
+
+    /*
+     * Generators of the symmetry group found: variable j is mapped onto
+     * variable generators_[g][j].
+     */
+    std::vector<std::vector<std::size_t>> generators_;
+
+    /*
+     * Constraints by their keys (used to check candidate automorphisms).
+     */
+    std::unordered_multimap<std::uint64_t, std::size_t> rows_by_key_;
+
+    /*
+     * Work done by refinements so far (number of vertices and edges visited).
+     */
+    std::size_t work_;
+    std::size_t graph_size_;
+
+    /*
+     * Scratch data structures.
+     */
+    std::vector<std::uint64_t> left_variable_colors_;
+    std::vector<std::uint64_t> left_row_colors_;
+    std::vector<std::uint64_t> right_variable_colors_;
+    std::vector<std::uint64_t> right_row_colors_;
+    std::vector<std::uint64_t> next_colors_;
+    std::vector<bool> marked_;
+    std::vector<double> marked_coefs_;
+
+    /*
+     * Values closer than this resolution are regarded as equal.
+     */
+    static constexpr double RESOLUTION = 1e-5;
+
+    /*
+     * Maximum number of refinement rounds.
+     */
+    static constexpr std::size_t MAX_ROUNDS = 32;
+
+    /*
+     * Maximum number of generators and budget of work of their search (number
+     * of vertices and edges visited by refinements).
+     */
+    static constexpr std::size_t MAX_GENERATORS = 64;
+    static constexpr std::size_t WORK_LIMIT = 500000000;
+};
+
+}
+
+#endif